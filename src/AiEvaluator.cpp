@@ -0,0 +1,219 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "AiEvaluator.h"
+#include "FrameArena.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+BoardSnapshot::BoardSnapshot(const TileMap& liveMap, const UnitStore& store)
+        : map(liveMap),
+          occupant((size_t)liveMap.width() * liveMap.depth(), -1)
+{
+    units.reserve(store.size());
+    for (std::uint32_t u = 0; u < store.size(); ++u) {
+        Unit unit;
+        unit.handle = store.handleAt(u);
+        unit.tile = map.tileAt(store.positions()[u]);
+        unit.team = store.teams()[u];
+        unit.hp = store.hp()[u];
+        if (map.inBounds(unit.tile.x, unit.tile.y)) {
+            occupant[(size_t)unit.tile.x * map.depth() + unit.tile.y] = (int)units.size();
+        }
+        units.push_back(unit);
+    }
+}
+
+static int manhattan(glm::ivec2 a, glm::ivec2 b)
+{
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+AiEvaluator::AiEvaluator(JobSystem& jobs)
+        : jobs_(jobs),
+          team_(0),
+          candidates_(0),
+          lastCandidates_(0)
+{
+}
+
+AiEvaluator::~AiEvaluator()
+{
+    // Jobs reference this object and the snapshot
+    jobs_.wait(counter_);
+}
+
+void AiEvaluator::beginTurn(std::shared_ptr<const BoardSnapshot> snapshot, std::uint8_t team)
+{
+    if (busy() || !snapshot) {
+        return;
+    }
+    snapshot_ = std::move(snapshot);
+    team_ = team;
+    candidates_ = 0;
+
+    actors_.clear();
+    for (int u = 0; u < (int)snapshot_->units.size(); ++u) {
+        const BoardSnapshot::Unit& unit = snapshot_->units[u];
+        if (unit.team == team_ && snapshot_->map.hasTile(unit.tile.x, unit.tile.y)) {
+            actors_.push_back(u);
+        }
+    }
+    plans_.resize(actors_.size());
+
+    // The previous turn's pathfinders point at the previous snapshot's map
+    pathfinders_.clear();
+
+    jobs_.parallelForAsync(actors_.size(), 1, [this](size_t begin, size_t end) {
+        PROFILE_SCOPE("ai unit");
+        std::unique_ptr<Pathfinder> pathfinder = acquirePathfinder();
+        for (size_t a = begin; a < end; ++a) {
+            evaluateUnit(a, *pathfinder);
+        }
+        releasePathfinder(std::move(pathfinder));
+    }, counter_);
+}
+
+std::unique_ptr<Pathfinder> AiEvaluator::acquirePathfinder()
+{
+    {
+        std::lock_guard<std::mutex> lock(poolMutex_);
+        if (!pathfinders_.empty()) {
+            std::unique_ptr<Pathfinder> pathfinder = std::move(pathfinders_.back());
+            pathfinders_.pop_back();
+            return pathfinder;
+        }
+    }
+    return std::make_unique<Pathfinder>(snapshot_->map);
+}
+
+void AiEvaluator::releasePathfinder(std::unique_ptr<Pathfinder> pathfinder)
+{
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    pathfinders_.push_back(std::move(pathfinder));
+}
+
+void AiEvaluator::evaluateUnit(size_t actor, Pathfinder& pathfinder)
+{
+    const BoardSnapshot& board = *snapshot_;
+    const BoardSnapshot::Unit& self = board.units[actors_[actor]];
+    std::vector<AiAction>& plan = plans_[actor];
+    plan.clear();
+
+    // Keeps the best keepPerUnit actions, best first
+    auto consider = [&](const AiAction& action) {
+        if ((int)plan.size() == settings_.keepPerUnit && action.score <= plan.back().score) {
+            return;
+        }
+        auto at = std::upper_bound(plan.begin(), plan.end(), action,
+                                   [](const AiAction& a, const AiAction& b) { return a.score > b.score; });
+        plan.insert(at, action);
+        if ((int)plan.size() > settings_.keepPerUnit) {
+            plan.pop_back();
+        }
+    };
+
+    // Per worker, released when the job returns
+    ScratchScope scratch;
+    std::pmr::vector<ReachableTile> reach(scratch.resource());
+    pathfinder.reachable(self.tile, settings_.moveBudget, reach);
+
+    const int threatRange = (int)settings_.moveBudget + 1;
+    long long scored = 0;
+    for (const ReachableTile& r : reach) {
+        const int occupant = board.occupantAt(r.tile);
+        if (occupant >= 0 && occupant != actors_[actor]) {
+            continue;
+        }
+
+        // Positional score: close the distance, avoid being swarmed, like high ground
+        int nearest = std::numeric_limits<int>::max();
+        int threats = 0;
+        for (const BoardSnapshot::Unit& other : board.units) {
+            if (other.team == team_) {
+                continue;
+            }
+            const int d = manhattan(r.tile, other.tile);
+            nearest = std::min(nearest, d);
+            threats += d <= threatRange ? 1 : 0;
+        }
+        const float height = board.map.height(r.tile.x, r.tile.y);
+        float base = 0.5f * height - 0.05f * r.cost - 1.5f * (float)threats;
+        if (nearest != std::numeric_limits<int>::max()) {
+            base -= 0.5f * (float)nearest;
+        }
+
+        AiAction move;
+        move.unit = self.handle;
+        move.move = r.tile;
+        move.score = base;
+        consider(move);
+        ++scored;
+
+        // Attacks open from this tile
+        for (const BoardSnapshot::Unit& other : board.units) {
+            if (other.team == team_ || manhattan(r.tile, other.tile) != 1) {
+                continue;
+            }
+            AiAction attack = move;
+            attack.attacks = true;
+            attack.target = other.handle;
+            attack.score = base + 10.0f
+                           + (other.hp <= settings_.attackDamage ? 15.0f : 0.0f)
+                           + 2.0f * (height - board.map.height(other.tile.x, other.tile.y));
+            consider(attack);
+            ++scored;
+        }
+    }
+
+    // Staying put is always possible
+    if (plan.empty()) {
+        AiAction stay;
+        stay.unit = self.handle;
+        stay.move = self.tile;
+        plan.push_back(stay);
+    }
+    candidates_.fetch_add(scored, std::memory_order_relaxed);
+}
+
+bool AiEvaluator::poll(std::vector<AiAction>& orders)
+{
+    if (!busy() || !counter_.done()) {
+        return false;
+    }
+    PROFILE_SCOPE("ai resolve");
+
+    // Strongest plans claim their tile first; the rest fall back to their
+    // next best option whose tile is still free
+    ScratchScope scratch;
+    std::pmr::vector<size_t> order(actors_.size(), scratch.resource());
+    for (size_t a = 0; a < order.size(); ++a) order[a] = a;
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return plans_[a].front().score > plans_[b].front().score;
+    });
+
+    const TileMap& map = snapshot_->map;
+    std::pmr::vector<std::uint8_t> claimed((size_t)map.width() * map.depth(), 0, scratch.resource());
+    orders.clear();
+    for (size_t a : order) {
+        const BoardSnapshot::Unit& self = snapshot_->units[actors_[a]];
+        AiAction chosen;
+        chosen.unit = self.handle;
+        chosen.move = self.tile; // nothing free: hold position
+        for (const AiAction& action : plans_[a]) {
+            if (!claimed[(size_t)action.move.x * map.depth() + action.move.y]) {
+                chosen = action;
+                break;
+            }
+        }
+        claimed[(size_t)chosen.move.x * map.depth() + chosen.move.y] = 1;
+        orders.push_back(chosen);
+    }
+
+    lastCandidates_ = candidates_.load();
+    snapshot_.reset();
+    return true;
+}
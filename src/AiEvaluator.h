@@ -0,0 +1,111 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_AIEVALUATOR_H
+#define TACTICGAME_AIEVALUATOR_H
+
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "JobSystem.h"
+#include "Pathfinder.h"
+#include "TileMap.h"
+#include "UnitStore.h"
+
+// Frozen copy of everything the AI looks at. Built on the simulation
+// thread, then shared read-only by every evaluation job, so the live
+// board can keep changing while a turn is being thought about.
+struct BoardSnapshot
+{
+    struct Unit
+    {
+        UnitHandle handle;
+        glm::ivec2 tile;
+        std::uint8_t team;
+        std::int16_t hp;
+    };
+
+    TileMap map;
+    std::vector<Unit> units;
+    std::vector<int> occupant; // per tile (map index order), index into units or -1
+
+    BoardSnapshot(const TileMap& map, const UnitStore& store);
+
+    int occupantAt(glm::ivec2 t) const
+    {
+        return map.inBounds(t.x, t.y) ? occupant[(size_t)t.x * map.depth() + t.y] : -1;
+    }
+};
+
+// One scored option for a unit: walk to `move`, then optionally attack
+struct AiAction
+{
+    UnitHandle unit;
+    glm::ivec2 move{-1, -1};
+    UnitHandle target;    // slot == invalid when just moving
+    bool attacks = false;
+    float score = 0.0f;
+};
+
+struct AiSettings
+{
+    float moveBudget = 4.0f;  // path cost a unit may spend per turn
+    int attackDamage = 3;
+    int keepPerUnit = 4;      // best candidates kept, for resolving tile clashes
+};
+
+// Plans one team's turn on the JobSystem. Each unit of the team is scored
+// by its own job: every reachable tile, with and without each attack open
+// from it, against one immutable BoardSnapshot. Runs asynchronously; the
+// frame loop polls for the orders, so a big turn never stalls rendering.
+class AiEvaluator
+{
+public:
+    explicit AiEvaluator(JobSystem& jobs);
+    ~AiEvaluator();
+
+    AiEvaluator(const AiEvaluator&) = delete;
+    AiEvaluator& operator=(const AiEvaluator&) = delete;
+
+    AiSettings& settings() { return settings_; }
+
+    // Starts planning `team`'s moves. Ignored while a turn is in flight.
+    void beginTurn(std::shared_ptr<const BoardSnapshot> snapshot, std::uint8_t team);
+    bool busy() const { return snapshot_ != nullptr; }
+
+    // Once the turn is done, fills one order per unit (no two units on the
+    // same tile) and returns true; false while still evaluating
+    bool poll(std::vector<AiAction>& orders);
+
+    // Candidates scored by the last finished turn
+    long long candidatesEvaluated() const { return lastCandidates_; }
+
+private:
+    JobSystem& jobs_;
+    AiSettings settings_;
+
+    std::shared_ptr<const BoardSnapshot> snapshot_;
+    std::uint8_t team_;
+    JobCounter counter_;
+    std::vector<int> actors_;                 // snapshot unit indices being planned
+    std::vector<std::vector<AiAction>> plans_; // per actor, best first
+    std::atomic<long long> candidates_;
+    long long lastCandidates_;
+
+    // Pathfinders bound to the current snapshot's map, checked out by jobs
+    std::mutex poolMutex_;
+    std::vector<std::unique_ptr<Pathfinder>> pathfinders_;
+
+    void evaluateUnit(size_t actor, Pathfinder& pathfinder);
+    std::unique_ptr<Pathfinder> acquirePathfinder();
+    void releasePathfinder(std::unique_ptr<Pathfinder> pathfinder);
+};
+
+
+#endif //TACTICGAME_AIEVALUATOR_H
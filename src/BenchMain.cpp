@@ -0,0 +1,376 @@
+//
+// Created by User on 14/10/2026.
+//
+// TacticGameBench: renders the game scene offscreen along a fixed camera
+// path and prints frame-time percentiles, draw calls and triangles as JSON.
+//
+//   TacticGameBench [--grid 10,100,500,1000] [--units 1,100] [--frames 600]
+//                   [--terrain chunked|instanced] [--no-cull]
+//                   [--shadows off|hard|pcf3|pcf5] [--prepass] [--out results.json]
+//
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Camera.h"
+#include "InstanceKernels.h"
+#include "SceneRenderer.h"
+#include "TileMap.h"
+#include "UnitStore.h"
+
+namespace {
+
+struct BenchOptions
+{
+    std::vector<int> gridSizes{10, 100, 500, 1000};
+    std::vector<int> unitCounts{1, 100};
+    int frames = 600;
+    bool chunked = true;
+    bool culling = true;
+    ShadowQuality shadows = ShadowQuality::Pcf3x3;
+    bool prepass = false;
+    std::string outPath; // empty = stdout
+    int width = 1280;
+    int height = 720;
+};
+
+struct BenchResult
+{
+    int gridSize;
+    int units;
+    int frames;
+    double p50, p90, p99, max, avg; // ms
+    double drawCalls;               // average per frame
+    double triangles;               // average per frame
+    double visibleChunks;           // average per frame
+    double visibleUnits;            // average per frame
+    double stateChanges;            // average per frame
+    double frameArenaBytes;         // most transient bytes in one frame
+};
+
+std::vector<int> parseList(const char* arg)
+{
+    std::vector<int> values;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(std::stoi(item));
+        }
+    }
+    return values;
+}
+
+bool parseArgs(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(arg, "--grid") && hasValue) {
+            opts.gridSizes = parseList(argv[++i]);
+        } else if (!std::strcmp(arg, "--units") && hasValue) {
+            opts.unitCounts = parseList(argv[++i]);
+        } else if (!std::strcmp(arg, "--frames") && hasValue) {
+            opts.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(arg, "--terrain") && hasValue) {
+            opts.chunked = std::strcmp(argv[++i], "instanced") != 0;
+        } else if (!std::strcmp(arg, "--no-cull")) {
+            opts.culling = false;
+        } else if (!std::strcmp(arg, "--shadows") && hasValue) {
+            const char* value = argv[++i];
+            if (!std::strcmp(value, "off")) {
+                opts.shadows = ShadowQuality::Off;
+            } else if (!std::strcmp(value, "hard")) {
+                opts.shadows = ShadowQuality::Hard;
+            } else if (!std::strcmp(value, "pcf3")) {
+                opts.shadows = ShadowQuality::Pcf3x3;
+            } else if (!std::strcmp(value, "pcf5")) {
+                opts.shadows = ShadowQuality::Pcf5x5;
+            } else {
+                std::fprintf(stderr, "Unknown shadow quality: %s\n", value);
+                return false;
+            }
+        } else if (!std::strcmp(arg, "--prepass")) {
+            opts.prepass = true;
+        } else if (!std::strcmp(arg, "--out") && hasValue) {
+            opts.outPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Deterministic unit placement: a fixed-seed LCG over the board, teams alternating
+void placeUnits(const TileMap& map, int count, float radius, UnitStore& units)
+{
+    units.clear();
+    std::uint32_t state = 12345u;
+    for (int n = 0; n < count; ++n) {
+        state = state * 1664525u + 1013904223u;
+        int i = (int)(state % (std::uint32_t)map.width());
+        state = state * 1664525u + 1013904223u;
+        int j = (int)(state % (std::uint32_t)map.depth());
+        glm::vec3 p = map.tileCenter(i, j);
+        p.y = map.topY(i, j) + radius;
+        UnitDesc desc;
+        desc.position = p;
+        desc.team = (std::uint8_t)(n % 2);
+        units.create(desc);
+    }
+}
+
+// First half of the run orbits the isometric camera around the board; the
+// second half flies the free camera diagonally across it, panning as it goes
+void cameraAt(Camera& camera, int frame, int frames, int gridSize, SceneView& out)
+{
+    const float half = gridSize / 2.0f;
+    const int orbitFrames = frames / 2;
+    const float depthRange = (float)gridSize * 2.0f + 20.0f;
+    camera.setDepthRange(-depthRange, depthRange);
+
+    if (frame < orbitFrames) {
+        const float t = (float)frame / (float)std::max(1, orbitFrames);
+        const float angle = t * 2.0f * 3.14159265f + 0.785398f; // start at the game's (1,1,1) view
+        camera.setMode(CameraMode::Isometric);
+        camera.setIsoCamPos(glm::vec3(std::cos(angle) * 2.8284f, 2.0f, std::sin(angle) * 2.8284f));
+        // Fit the whole board like a zoomed-out player would
+        camera.setZoomLevel(std::max(10.0f, half * 1.5f));
+    } else {
+        const float t = (float)(frame - orbitFrames) / (float)std::max(1, frames - orbitFrames);
+        const glm::vec3 from(-half, 2.0f + half * 0.2f, -half);
+        const glm::vec3 to(half, 2.0f + half * 0.2f, half);
+        camera.setMode(CameraMode::Free);
+        camera.setFreeCam(glm::mix(from, to, t), 45.0f + 90.0f * std::sin(t * 6.2831853f), -30.0f);
+        camera.setZoomLevel(10.0f);
+    }
+    out = camera.sceneView();
+}
+
+// Same command list the game records each frame, executed inline here
+void recordFrame(const SceneView& view, const UnitStore& units, RenderFrame& frame)
+{
+    frame.clear();
+    frame.units.positions = units.positions();
+    frame.units.copyFrom(units);
+    frame.setView(view);
+    frame.drawTerrain();
+    frame.drawUnits();
+}
+
+double percentile(std::vector<double> sorted, double p)
+{
+    if (sorted.empty()) return 0.0;
+    std::sort(sorted.begin(), sorted.end());
+    size_t k = (size_t)std::llround(p * (double)(sorted.size() - 1));
+    return sorted[k];
+}
+
+BenchResult runCase(const BenchOptions& opts, int gridSize, int unitCount)
+{
+    TileMap map(gridSize, gridSize);
+    SceneRenderer renderer(map);
+    renderer.setChunkedTerrain(opts.chunked);
+    renderer.setCulling(opts.culling);
+    renderer.setShadowQuality(opts.shadows);
+    renderer.setDepthPrepass(opts.prepass);
+    UnitStore units;
+    placeUnits(map, unitCount, renderer.sphereRadius(), units);
+
+    Camera camera;
+    SceneView view;
+    RenderFrame frame;
+
+    // A few frames to bake chunks and warm up driver state, and keep going
+    // until every texture has streamed in so no upload lands in the timings
+    for (int f = 0; f < 10 || renderer.textures().pendingCount() > 0; ++f) {
+        cameraAt(camera, 0, opts.frames, gridSize, view);
+        recordFrame(view, units, frame);
+        renderer.execute(frame);
+    }
+    glFinish();
+
+    std::vector<double> frameMs;
+    frameMs.reserve(opts.frames);
+    double drawCalls = 0.0;
+    double triangles = 0.0;
+    double visibleChunks = 0.0;
+    double visibleUnits = 0.0;
+    double stateChanges = 0.0;
+    std::size_t frameArenaBytes = 0;
+
+    for (int f = 0; f < opts.frames; ++f) {
+        auto start = std::chrono::steady_clock::now();
+        cameraAt(camera, f, opts.frames, gridSize, view);
+        recordFrame(view, units, frame);
+        renderer.execute(frame);
+        // Include GPU time so the number reflects the whole frame
+        glFinish();
+        auto end = std::chrono::steady_clock::now();
+
+        frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        drawCalls += renderer.stats().drawCalls;
+        triangles += (double)renderer.stats().triangles;
+        visibleChunks += renderer.stats().visibleChunks;
+        visibleUnits += renderer.stats().visibleUnits;
+        stateChanges += renderer.stats().stateChanges;
+        frameArenaBytes = std::max(frameArenaBytes, renderer.stats().frameArenaBytes);
+    }
+
+    BenchResult r{};
+    r.gridSize = gridSize;
+    r.units    = unitCount;
+    r.frames   = opts.frames;
+    r.p50      = percentile(frameMs, 0.50);
+    r.p90      = percentile(frameMs, 0.90);
+    r.p99      = percentile(frameMs, 0.99);
+    r.max      = *std::max_element(frameMs.begin(), frameMs.end());
+    double sum = 0.0;
+    for (double ms : frameMs) sum += ms;
+    r.avg       = sum / (double)frameMs.size();
+    r.drawCalls = drawCalls / opts.frames;
+    r.triangles = triangles / opts.frames;
+    r.visibleChunks = visibleChunks / opts.frames;
+    r.visibleUnits  = visibleUnits / opts.frames;
+    r.stateChanges  = stateChanges / opts.frames;
+    r.frameArenaBytes = (double)frameArenaBytes;
+    return r;
+}
+
+std::string toJson(const BenchOptions& opts, const std::vector<BenchResult>& results)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("renderer"); writer.String(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    writer.Key("terrain");  writer.String(opts.chunked ? "chunked" : "instanced");
+    writer.Key("culling");  writer.Bool(opts.culling);
+    writer.Key("depthPrepass"); writer.Bool(opts.prepass);
+    writer.Key("shadowPcfRadius"); writer.Int(opts.shadows == ShadowQuality::Off ? -1 : shadowPcfRadius(opts.shadows));
+    writer.Key("instanceKernel"); writer.String(instanceKernelName());
+    writer.Key("width");    writer.Int(opts.width);
+    writer.Key("height");   writer.Int(opts.height);
+    writer.Key("results");
+    writer.StartArray();
+    for (const BenchResult& r : results) {
+        writer.StartObject();
+        writer.Key("gridSize");     writer.Int(r.gridSize);
+        writer.Key("units");        writer.Int(r.units);
+        writer.Key("frames");       writer.Int(r.frames);
+        writer.Key("frameMsP50");   writer.Double(r.p50);
+        writer.Key("frameMsP90");   writer.Double(r.p90);
+        writer.Key("frameMsP99");   writer.Double(r.p99);
+        writer.Key("frameMsMax");   writer.Double(r.max);
+        writer.Key("frameMsAvg");   writer.Double(r.avg);
+        writer.Key("drawCalls");    writer.Double(r.drawCalls);
+        writer.Key("triangles");    writer.Double(r.triangles);
+        writer.Key("visibleChunks"); writer.Double(r.visibleChunks);
+        writer.Key("visibleUnits"); writer.Double(r.visibleUnits);
+        writer.Key("stateChanges"); writer.Double(r.stateChanges);
+        writer.Key("frameArenaBytes"); writer.Double(r.frameArenaBytes);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        return 2;
+    }
+
+    // stdout carries the JSON report; keep log lines on stderr
+    spdlog::set_default_logger(spdlog::stderr_color_mt("bench"));
+
+    if (!glfwInit()) {
+        std::fprintf(stderr, "Failed to init GLFW\n");
+        return -1;
+    }
+
+    // Hidden window: we only need its context and render into our own FBO
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(opts.width, opts.height, "TacticGameBench", nullptr, nullptr);
+    if (!window) {
+        std::fprintf(stderr, "Failed to create window\n");
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::fprintf(stderr, "Failed to init GLAD\n");
+        return -1;
+    }
+
+    // Offscreen target so results don't depend on how the platform treats
+    // the default framebuffer of an invisible window
+    unsigned int fbo, colorRb, depthRb;
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &colorRb);
+    glGenRenderbuffers(1, &depthRb);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRb);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, opts.width, opts.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRb);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, opts.width, opts.height);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRb);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRb);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::fprintf(stderr, "Offscreen framebuffer incomplete\n");
+        return -1;
+    }
+
+    glViewport(0, 0, opts.width, opts.height);
+    glEnable(GL_DEPTH_TEST);
+    glClearColor(0.7f, 0.7f, 0.7f, 1.0f);
+
+    std::vector<BenchResult> results;
+    for (int gridSize : opts.gridSizes) {
+        for (int units : opts.unitCounts) {
+            spdlog::info("bench: grid {} units {} ({} frames)", gridSize, units, opts.frames);
+            results.push_back(runCase(opts, gridSize, units));
+        }
+    }
+
+    const std::string json = toJson(opts, results);
+    if (opts.outPath.empty()) {
+        std::fwrite(json.data(), 1, json.size(), stdout);
+        std::fputc('\n', stdout);
+    } else {
+        std::ofstream out(opts.outPath, std::ios::binary);
+        out << json << '\n';
+    }
+
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &colorRb);
+    glDeleteRenderbuffers(1, &depthRb);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -3,6 +3,7 @@
 //
 
 #include "Camera.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -18,12 +19,25 @@ Camera::Camera()
           firstMouse_(true),
           lastX_(400.f),
           lastY_(300.f),
-          freeCamSpeed_(0.05f),
+          freeCamSpeed_(3.0f),
           mouseSensitivity_(0.1f),
-          zoomLevel_(10.f) // default
+          zoomLevel_(10.f), // default
+          nearPlane_(-10.f),
+          farPlane_(10.f),
+          inverseViewProjection_(1.0f),
+          viewDirty_(true),
+          projectionDirty_(true),
+          inverseDirty_(true),
+          revision_(0)
 {
 }
 
+void SceneView::update()
+{
+    viewProjection = projection * view;
+    frustum.set(viewProjection);
+}
+
 void Camera::toggleMode()
 {
     if (mode_ == CameraMode::Isometric)
@@ -32,6 +46,28 @@ void Camera::toggleMode()
         mode_ = CameraMode::Isometric;
 
     firstMouse_ = true; // so mouse offsets don’t jump
+    viewDirty_ = true;
+}
+
+void Camera::setMode(CameraMode mode)
+{
+    if (mode_ != mode) {
+        toggleMode();
+    }
+}
+
+void Camera::setIsoCamPos(const glm::vec3& pos)
+{
+    isoCamPos_ = pos;
+    viewDirty_ = true;
+}
+
+void Camera::setFreeCam(const glm::vec3& pos, float yaw, float pitch)
+{
+    freeCamPos_ = pos;
+    yaw_   = yaw;
+    pitch_ = pitch;
+    updateFront();
 }
 
 // Update isometric camera – in your example code you keep it fixed at isoCamPos_,
@@ -47,6 +83,9 @@ void Camera::updateFree(float deltaTime, bool upArrow, bool downArrow, bool left
 {
     // Move freeCamPos_ with arrow keys (or WASD, if you prefer).
     // We compute direction vectors for forward/back, left/right.
+    if (!upArrow && !downArrow && !leftArrow && !rightArrow) {
+        return;
+    }
     glm::vec3 forward  = cameraFront_;
     glm::vec3 rightVec = glm::normalize(glm::cross(cameraFront_, cameraUp_));
 
@@ -66,6 +105,25 @@ void Camera::updateFree(float deltaTime, bool upArrow, bool downArrow, bool left
     {
         freeCamPos_ += rightVec * freeCamSpeed_ * deltaTime;
     }
+    viewDirty_ = true;
+}
+
+void Camera::setZoomLevel(float zoom)
+{
+    zoomLevel_ = zoom;
+    projectionDirty_ = true;
+}
+
+void Camera::zoomBy(float scrollSteps)
+{
+    setZoomLevel(std::max(0.1f, zoomLevel_ - scrollSteps * 0.1f));
+}
+
+void Camera::setDepthRange(float nearPlane, float farPlane)
+{
+    nearPlane_ = nearPlane;
+    farPlane_  = farPlane;
+    projectionDirty_ = true;
 }
 
 // Handle mouse movement only for free camera
@@ -82,6 +140,9 @@ void Camera::handleMouse(double xpos, double ypos)
     }
 
     float xoffset = float(xpos) - lastX_;
+    if (xoffset == 0.0f && float(ypos) == lastY_) {
+        return;
+    }
     float yoffset = lastY_ - float(ypos); // reversed: screen coords
     lastX_ = float(xpos);
     lastY_ = float(ypos);
@@ -96,25 +157,65 @@ void Camera::handleMouse(double xpos, double ypos)
     if (pitch_ > 89.0f)  pitch_ = 89.0f;
     if (pitch_ < -89.0f) pitch_ = -89.0f;
 
-    // Recompute cameraFront_
+    updateFront();
+}
+
+// Recompute cameraFront_ from yaw/pitch
+void Camera::updateFront()
+{
     glm::vec3 direction;
     direction.x = cos(glm::radians(yaw_)) * cos(glm::radians(pitch_));
     direction.y = sin(glm::radians(pitch_));
     direction.z = sin(glm::radians(yaw_)) * cos(glm::radians(pitch_));
     cameraFront_ = glm::normalize(direction);
+    viewDirty_ = true;
 }
 
-// Return the current view matrix based on mode
-glm::mat4 Camera::getViewMatrix() const
+void Camera::refresh() const
 {
-    if (mode_ == CameraMode::Isometric)
-    {
-        // Look from isoCamPos_ at the origin
-        return glm::lookAt(isoCamPos_, glm::vec3(0.0f, 0.0f, 0.0f), cameraUp_);
+    if (!viewDirty_ && !projectionDirty_) {
+        return;
     }
-    else
-    {
-        // Free camera
-        return glm::lookAt(freeCamPos_, freeCamPos_ + cameraFront_, cameraUp_);
+    if (viewDirty_) {
+        if (mode_ == CameraMode::Isometric) {
+            // Look from isoCamPos_ at the origin
+            view_.view = glm::lookAt(isoCamPos_, glm::vec3(0.0f, 0.0f, 0.0f), cameraUp_);
+        } else {
+            // Free camera
+            view_.view = glm::lookAt(freeCamPos_, freeCamPos_ + cameraFront_, cameraUp_);
+        }
+        // For lighting calcs, the shader gets the position of the active camera
+        view_.viewPos = position();
+    }
+    if (projectionDirty_) {
+        // Orthographic projection => isometric style
+        view_.projection = glm::ortho(-zoomLevel_, zoomLevel_, -zoomLevel_, zoomLevel_, nearPlane_, farPlane_);
     }
-}
\ No newline at end of file
+    view_.update();
+    viewDirty_ = false;
+    projectionDirty_ = false;
+    inverseDirty_ = true;
+    ++revision_;
+}
+
+const SceneView& Camera::sceneView() const
+{
+    refresh();
+    return view_;
+}
+
+const glm::mat4& Camera::inverseViewProjection() const
+{
+    refresh();
+    if (inverseDirty_) {
+        inverseViewProjection_ = glm::inverse(view_.viewProjection);
+        inverseDirty_ = false;
+    }
+    return inverseViewProjection_;
+}
+
+std::uint32_t Camera::revision() const
+{
+    refresh();
+    return revision_;
+}
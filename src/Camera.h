@@ -6,23 +6,53 @@
 #define TACTICGAME_CAMERA_H
 
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "Frustum.h"
+
 enum class CameraMode
 {
     Isometric,
     Free
 };
 
+// Camera state for one rendered frame, with what culling and the frame
+// uniforms derive from it already worked out
+struct SceneView
+{
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    glm::mat4 viewProjection{1.0f};
+    glm::vec3 viewPos{0.0f};
+    Frustum frustum;
+
+    // Fills viewProjection and frustum from view and projection, for views
+    // built by hand rather than taken from a Camera
+    void update();
+};
+
+// The game's camera: an isometric one looking at the origin and a free
+// fly camera, both under an orthographic projection sized by the zoom.
+//
+// Matrices and frustum planes are cached. Setters only mark them dirty;
+// the first read afterwards recomputes what changed, so a frame where the
+// camera didn't move costs nothing. revision() changes with every
+// recompute, for callers that cache on top of the camera.
 class Camera
 {
 public:
     Camera();
 
     void toggleMode();
+    void setMode(CameraMode mode);
     CameraMode getMode() const { return mode_; }
 
+    // Place the cameras directly (scripted paths, benchmarks)
+    void setIsoCamPos(const glm::vec3& pos);
+    void setFreeCam(const glm::vec3& pos, float yaw, float pitch);
+
     // Update camera each frame (handle keyboard, etc.)
     //  - pass in whatever input state you want (e.g. GLFW keys)
     void updateIsometric();
@@ -31,17 +61,34 @@ public:
     // Mouse movement for free camera
     void handleMouse(double xpos, double ypos);
 
-    // Return current view matrix based on the mode
-    glm::mat4 getViewMatrix() const;
-
-    // Orthographic “zoom” for isometric
-    float& zoomLevel() { return zoomLevel_; }
+    // Orthographic “zoom” for isometric: half the view height in world units
+    float zoomLevel() const { return zoomLevel_; }
+    void setZoomLevel(float zoom);
+    // Scroll wheel steps, clamped so the view never inverts
+    void zoomBy(float scrollSteps);
+    // View-space depth range of the ortho box
+    void setDepthRange(float nearPlane, float farPlane);
 
     // Positions (if you need them for lighting calculations, etc.)
     const glm::vec3& freeCamPos() const { return freeCamPos_; }
     const glm::vec3& isoCamPos()  const { return isoCamPos_; }
+    // The active mode's position
+    const glm::vec3& position() const { return mode_ == CameraMode::Isometric ? isoCamPos_ : freeCamPos_; }
+
+    // Cached, see above
+    const glm::mat4& getViewMatrix() const { return sceneView().view; }
+    const glm::mat4& projection() const { return sceneView().projection; }
+    const glm::mat4& viewProjection() const { return sceneView().viewProjection; }
+    const glm::mat4& inverseViewProjection() const;
+    const Frustum& frustum() const { return sceneView().frustum; }
+    const SceneView& sceneView() const;
+    std::uint32_t revision() const;
 
 private:
+    void updateFront();
+    // Recomputes whatever the dirty flags say is stale
+    void refresh() const;
+
     CameraMode mode_;
 
     // For isometric camera
@@ -62,11 +109,21 @@ private:
     float lastY_;
 
     // Speeds, etc.
-    float freeCamSpeed_;
+    float freeCamSpeed_;      // world units per second
     float mouseSensitivity_;
 
     // Zoom for orthographic isometric camera
     float zoomLevel_;
+    float nearPlane_;
+    float farPlane_;
+
+    // Derived state
+    mutable SceneView view_;
+    mutable glm::mat4 inverseViewProjection_;
+    mutable bool viewDirty_;
+    mutable bool projectionDirty_;
+    mutable bool inverseDirty_;
+    mutable std::uint32_t revision_;
 };
 
 
@@ -0,0 +1,133 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "FileWatcher.h"
+#include "Resources.h"
+#include <algorithm>
+#include <utility>
+
+FileWatcher::FileWatcher(double intervalSeconds)
+        : interval_(intervalSeconds),
+          hasChanges_(false),
+          stopping_(false)
+{
+    thread_ = std::thread(&FileWatcher::run, this);
+}
+
+FileWatcher::~FileWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+}
+
+void FileWatcher::watch(const std::string& path, bool readContents)
+{
+    Watch watch;
+    watch.path = path;
+    watch.readContents = readContents;
+    refresh(watch);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Watch& existing : watches_) {
+        if (existing.path == path) {
+            existing.readContents = existing.readContents || readContents;
+            return;
+        }
+    }
+    watches_.push_back(std::move(watch));
+}
+
+void FileWatcher::setOnChange(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    onChange_ = std::move(callback);
+}
+
+void FileWatcher::takeChanges(std::vector<FileChange>& changes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    changes = std::move(changes_);
+    changes_.clear();
+    hasChanges_.store(false, std::memory_order_release);
+}
+
+bool FileWatcher::refresh(Watch& watch)
+{
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(watch.path, error);
+    if (error) {
+        // Gone, or mid-rename; whatever lands there next counts as a change
+        watch.exists = false;
+        return false;
+    }
+    const std::uintmax_t size = std::filesystem::file_size(watch.path, error);
+    const bool changed = !watch.exists || modified != watch.modified || (!error && size != watch.size);
+    watch.exists = true;
+    watch.modified = modified;
+    watch.size = error ? watch.size : size;
+    return changed;
+}
+
+void FileWatcher::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait_for(lock, interval_, [this] { return stopping_; });
+        if (stopping_) {
+            return;
+        }
+
+        // Stat and read without the lock; watch() may add entries meanwhile
+        std::vector<Watch> watches = watches_;
+        lock.unlock();
+
+        std::vector<FileChange> found;
+        for (Watch& watch : watches) {
+            if (!refresh(watch)) {
+                continue;
+            }
+            FileChange change;
+            change.path = watch.path;
+            if (watch.readContents) {
+                change.readable = readTextFile(watch.path, change.contents);
+            }
+            found.push_back(std::move(change));
+        }
+
+        lock.lock();
+        for (const Watch& watch : watches) {
+            auto it = std::find_if(watches_.begin(), watches_.end(),
+                                   [&](const Watch& w) { return w.path == watch.path; });
+            if (it != watches_.end()) {
+                it->exists = watch.exists;
+                it->modified = watch.modified;
+                it->size = watch.size;
+            }
+        }
+        if (found.empty()) {
+            continue;
+        }
+        for (FileChange& change : found) {
+            // A newer save replaces one still waiting to be taken
+            auto it = std::find_if(changes_.begin(), changes_.end(),
+                                   [&](const FileChange& c) { return c.path == change.path; });
+            if (it != changes_.end()) {
+                *it = std::move(change);
+            } else {
+                changes_.push_back(std::move(change));
+            }
+        }
+        hasChanges_.store(true, std::memory_order_release);
+        std::function<void()> onChange = onChange_;
+        lock.unlock();
+        if (onChange) {
+            onChange();
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,83 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_FILEWATCHER_H
+#define TACTICGAME_FILEWATCHER_H
+
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct FileChange
+{
+    std::string path;     // as passed to watch()
+    std::string contents; // the new text, for paths watched with readContents
+    bool readable = true; // false if the read failed (contents empty)
+};
+
+// Background thread that polls the modification time of a set of files and
+// queues the ones that changed, for hot reload. Polling a handful of stats
+// a few times a second costs nothing and behaves the same everywhere,
+// including editors that save by writing a new file and renaming it over
+// the old one. Files that vanish are reported again once they reappear.
+//
+// The owner collects changes with takeChanges() whenever it likes (the
+// renderer does at the start of a frame), so nothing is swapped mid-frame.
+class FileWatcher
+{
+public:
+    explicit FileWatcher(double intervalSeconds = 0.25);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Watches `path` from its current state on. With readContents the
+    // watcher thread also reads the changed file, so the owner never
+    // touches the disk.
+    void watch(const std::string& path, bool readContents = false);
+
+    // Runs on the watcher thread after it queued changes, e.g. to wake an
+    // event loop sleeping until input
+    void setOnChange(std::function<void()> callback);
+
+    bool hasChanges() const { return hasChanges_.load(std::memory_order_acquire); }
+    // Moves out everything queued since the last call, one entry per path
+    void takeChanges(std::vector<FileChange>& changes);
+
+private:
+    struct Watch
+    {
+        std::string path;
+        bool readContents = false;
+        bool exists = false;
+        std::filesystem::file_time_type modified{};
+        std::uintmax_t size = 0;
+    };
+
+    const std::chrono::duration<double> interval_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Watch> watches_;
+    std::vector<FileChange> changes_;
+    std::function<void()> onChange_;
+    std::atomic<bool> hasChanges_;
+    bool stopping_;
+    std::thread thread_;
+
+    void run();
+    // Re-stats `watch`; true if it changed since the last look
+    static bool refresh(Watch& watch);
+};
+
+
+#endif //TACTICGAME_FILEWATCHER_H
@@ -0,0 +1,251 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "FogOfWar.h"
+#include "TileMap.h"
+#include <algorithm>
+
+// Octant transforms for the recursive shadowcast
+static const int kOctants[8][4] = {
+        { 1,  0,  0,  1}, { 0,  1,  1,  0}, { 0, -1,  1,  0}, {-1,  0,  0,  1},
+        {-1,  0,  0, -1}, { 0, -1, -1,  0}, { 0,  1, -1,  0}, { 1,  0,  0, -1},
+};
+
+static bool testBit(const std::vector<std::uint64_t>& bits, size_t index)
+{
+    return (bits[index >> 6] >> (index & 63)) & 1u;
+}
+
+FogOfWar::FogOfWar(const TileMap& map)
+        : map_(map),
+          updateStamp_(0),
+          recast_(0),
+          changed_(false),
+          castStamp_(0)
+{
+    const size_t tiles = (size_t)map_.width() * map_.depth();
+    for (TeamVision& team : teams_) {
+        team.viewers.assign(tiles, 0);
+        team.visible.assign((tiles + 63) / 64, 0);
+        team.explored.assign((tiles + 63) / 64, 0);
+    }
+    castMark_.assign(tiles, 0);
+}
+
+bool FogOfWar::update(const UnitStore& units)
+{
+    ++updateStamp_;
+    recast_ = 0;
+    changed_ = false;
+
+    const std::vector<glm::vec3>& positions = units.positions();
+    const std::vector<std::uint8_t>& teams = units.teams();
+    const std::vector<std::uint8_t>& vision = units.visionRadii();
+    for (std::uint32_t u = 0; u < units.size(); ++u) {
+        const UnitHandle handle = units.handleAt(u);
+        if (handle.slot >= viewers_.size()) {
+            viewers_.resize(handle.slot + 1);
+        }
+        Viewer& viewer = viewers_[handle.slot];
+        viewer.seen = updateStamp_;
+
+        const glm::ivec2 tile = map_.tileAt(positions[u]);
+        const std::uint8_t team = (std::uint8_t)std::min<int>(teams[u], kMaxTeams - 1);
+        const int radius = vision[u];
+        const bool stale = !viewer.active
+                           || viewer.generation != handle.generation
+                           || viewer.tile != tile
+                           || viewer.radius != radius
+                           || viewer.team != team
+                           || mapChangedNear(viewer);
+        if (!stale) {
+            continue;
+        }
+
+        if (viewer.active) {
+            remove(viewer);
+        }
+        viewer.active = true;
+        viewer.generation = handle.generation;
+        viewer.tile = tile;
+        viewer.radius = radius;
+        viewer.team = team;
+        cast(viewer);
+        add(viewer);
+        ++recast_;
+    }
+
+    // Units gone since the last update stop seeing
+    for (Viewer& viewer : viewers_) {
+        if (viewer.active && viewer.seen != updateStamp_) {
+            remove(viewer);
+            viewer.active = false;
+            viewer.tiles.clear();
+        }
+    }
+    return changed_;
+}
+
+// Only chunks under the viewer's radius matter. TileMap tags edited chunks
+// with the map revision the edit produced, so "newer than my cast" is a
+// compare per chunk.
+bool FogOfWar::mapChangedNear(Viewer& viewer) const
+{
+    if (viewer.mapRevision == map_.revision()) {
+        return false;
+    }
+    const int r = viewer.radius + 1; // blockers just outside still cast inward
+    const int cx0 = std::max(0, (viewer.tile.x - r) / kChunkSize);
+    const int cz0 = std::max(0, (viewer.tile.y - r) / kChunkSize);
+    const int cx1 = std::min(map_.chunksX() - 1, std::max(0, viewer.tile.x + r) / kChunkSize);
+    const int cz1 = std::min(map_.chunksZ() - 1, std::max(0, viewer.tile.y + r) / kChunkSize);
+    for (int cz = cz0; cz <= cz1; ++cz) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            if (map_.chunkRevision(cx, cz) > viewer.mapRevision) {
+                return true;
+            }
+        }
+    }
+    viewer.mapRevision = map_.revision(); // nothing nearby; skip the scan next time
+    return false;
+}
+
+bool FogOfWar::blocksSight(int i, int j, float eye) const
+{
+    return !map_.inBounds(i, j) || map_.height(i, j) > eye;
+}
+
+void FogOfWar::markSeen(Viewer& viewer, int i, int j)
+{
+    const int index = i * map_.depth() + j;
+    if (castMark_[index] != castStamp_) {
+        castMark_[index] = castStamp_;
+        viewer.tiles.push_back(index);
+    }
+}
+
+void FogOfWar::cast(Viewer& viewer)
+{
+    viewer.tiles.clear();
+    viewer.mapRevision = map_.revision();
+    if (!map_.inBounds(viewer.tile.x, viewer.tile.y)) {
+        return;
+    }
+    if (++castStamp_ == 0) {
+        std::fill(castMark_.begin(), castMark_.end(), 0u);
+        castStamp_ = 1;
+    }
+
+    const float eye = map_.height(viewer.tile.x, viewer.tile.y) + kEyeHeight;
+    markSeen(viewer, viewer.tile.x, viewer.tile.y);
+    for (const int* o : kOctants) {
+        castOctant(viewer, eye, 1, 1.0f, 0.0f, o[0], o[1], o[2], o[3]);
+    }
+}
+
+// Recursive shadowcasting over one octant: scans rows outward, narrowing
+// the [end, start] slope window around blockers and recursing past each one
+void FogOfWar::castOctant(Viewer& viewer, float eye, int row, float start, float end,
+                          int xx, int xy, int yx, int yy)
+{
+    if (start < end) {
+        return;
+    }
+    const int radius = viewer.radius;
+    const int radiusSq = radius * radius + radius; // rounder edge than r*r
+    float newStart = 0.0f;
+    for (int j = row; j <= radius; ++j) {
+        bool blocked = false;
+        const int dy = -j;
+        for (int dx = -j; dx <= 0; ++dx) {
+            const int x = viewer.tile.x + dx * xx + dy * xy;
+            const int y = viewer.tile.y + dx * yx + dy * yy;
+            const float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            const float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (start < rightSlope) {
+                continue;
+            }
+            if (end > leftSlope) {
+                break;
+            }
+
+            if (dx * dx + dy * dy <= radiusSq && map_.inBounds(x, y)) {
+                markSeen(viewer, x, y);
+            }
+
+            const bool wall = blocksSight(x, y, eye);
+            if (blocked) {
+                if (wall) {
+                    newStart = rightSlope;
+                } else {
+                    blocked = false;
+                    start = newStart;
+                }
+            } else if (wall && j < radius) {
+                blocked = true;
+                castOctant(viewer, eye, j + 1, start, leftSlope, xx, xy, yx, yy);
+                newStart = rightSlope;
+            }
+        }
+        if (blocked) {
+            break;
+        }
+    }
+}
+
+void FogOfWar::add(const Viewer& viewer)
+{
+    TeamVision& team = teams_[viewer.team];
+    for (int index : viewer.tiles) {
+        if (team.viewers[index]++ == 0) {
+            team.visible[index >> 6] |= 1ull << (index & 63);
+            team.explored[index >> 6] |= 1ull << (index & 63);
+            ++team.revision;
+            changed_ = true;
+        }
+    }
+}
+
+void FogOfWar::remove(const Viewer& viewer)
+{
+    TeamVision& team = teams_[viewer.team];
+    for (int index : viewer.tiles) {
+        if (--team.viewers[index] == 0) {
+            team.visible[index >> 6] &= ~(1ull << (index & 63));
+            ++team.revision;
+            changed_ = true;
+        }
+    }
+}
+
+bool FogOfWar::visible(int team, glm::ivec2 tile) const
+{
+    if (!map_.inBounds(tile.x, tile.y)) {
+        return false;
+    }
+    return testBit(teams_[team].visible, (size_t)tile.x * map_.depth() + tile.y);
+}
+
+bool FogOfWar::explored(int team, glm::ivec2 tile) const
+{
+    if (!map_.inBounds(tile.x, tile.y)) {
+        return false;
+    }
+    return testBit(teams_[team].explored, (size_t)tile.x * map_.depth() + tile.y);
+}
+
+void FogOfWar::buildMask(int team, std::vector<std::uint8_t>& out) const
+{
+    const int width = map_.width();
+    const int depth = map_.depth();
+    const TeamVision& vision = teams_[team];
+    out.resize((size_t)width * depth);
+    for (int j = 0; j < depth; ++j) {
+        for (int i = 0; i < width; ++i) {
+            const size_t index = (size_t)i * depth + j;
+            out[(size_t)j * width + i] = testBit(vision.visible, index) ? 255
+                                       : testBit(vision.explored, index) ? 96 : 0;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_FOGOFWAR_H
+#define TACTICGAME_FOGOFWAR_H
+
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "UnitStore.h"
+
+class TileMap;
+
+// Per-team visibility over the tile grid. Each unit sees the tiles its
+// shadowcast from its tile reaches within its vision radius; a team sees a
+// tile while at least one of its units does, and has explored it once any
+// has. Kept as a per-tile viewer count plus bitsets.
+//
+// update() is incremental: only units that moved tile, changed vision or
+// team, appeared, died, or had the map edited within their radius are
+// recast, and only the tiles they saw or now see are touched.
+//
+// Sight is blocked by tiles whose top is above the viewer's eye
+// (kEyeHeight over its own tile) and by the map edge; holes don't block.
+class FogOfWar
+{
+public:
+    static constexpr int kMaxTeams = 4;
+    static constexpr float kEyeHeight = 0.75f;
+
+    explicit FogOfWar(const TileMap& map);
+
+    // Returns true if any team's visible or explored set changed
+    bool update(const UnitStore& units);
+
+    bool visible(int team, glm::ivec2 tile) const;
+    bool explored(int team, glm::ivec2 tile) const;
+
+    // Bumped whenever the team's visible/explored sets change
+    std::uint32_t revision(int team) const { return teams_[team].revision; }
+
+    // R8 texture data for one team, row t = tile j, texel s = tile i:
+    // 255 visible, 96 explored, 0 never seen
+    void buildMask(int team, std::vector<std::uint8_t>& out) const;
+
+    // Units recast by the last update(), for profiling
+    int recastLastUpdate() const { return recast_; }
+
+private:
+    struct TeamVision
+    {
+        std::vector<std::uint16_t> viewers;  // per tile
+        std::vector<std::uint64_t> visible;  // bit per tile
+        std::vector<std::uint64_t> explored;
+        std::uint32_t revision = 0;
+    };
+
+    // Last cast of one unit, indexed by UnitHandle::slot
+    struct Viewer
+    {
+        bool active = false;
+        std::uint32_t generation = 0;
+        std::uint32_t seen = 0; // update stamp, for spotting removed units
+        std::uint8_t team = 0;
+        int radius = 0;
+        glm::ivec2 tile{0, 0};
+        std::uint32_t mapRevision = 0;
+        std::vector<int> tiles;   // tile indices it sees
+    };
+
+    const TileMap& map_;
+    TeamVision teams_[kMaxTeams];
+    std::vector<Viewer> viewers_;
+    std::uint32_t updateStamp_;
+    int recast_;
+    bool changed_;
+
+    // Dedupes tiles shared by neighbouring octants within one cast
+    std::vector<std::uint32_t> castMark_;
+    std::uint32_t castStamp_;
+
+    bool mapChangedNear(Viewer& viewer) const;
+    void cast(Viewer& viewer);
+    void castOctant(Viewer& viewer, float eye, int row, float start, float end,
+                    int xx, int xy, int yx, int yy);
+    bool blocksSight(int i, int j, float eye) const;
+    void markSeen(Viewer& viewer, int i, int j);
+    void add(const Viewer& viewer);
+    void remove(const Viewer& viewer);
+};
+
+
+#endif //TACTICGAME_FOGOFWAR_H
@@ -0,0 +1,126 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "FrameArena.h"
+#include <algorithm>
+
+namespace {
+
+// Block starts are aligned for anything a container will ask for
+constexpr std::size_t kBlockAlign = alignof(std::max_align_t) > 64 ? alignof(std::max_align_t) : 64;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+LinearArena::LinearArena(std::size_t initialBytes, std::pmr::memory_resource* upstream)
+        : upstream_(upstream),
+          current_(0),
+          offset_(0),
+          spent_(0),
+          highWater_(0),
+          upstreamAllocations_(0)
+{
+    if (initialBytes > 0) {
+        addBlock(initialBytes);
+    }
+}
+
+LinearArena::~LinearArena()
+{
+    releaseBlocks();
+}
+
+std::size_t LinearArena::capacity() const
+{
+    std::size_t total = 0;
+    for (const Block& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+void LinearArena::addBlock(std::size_t bytes)
+{
+    bytes = alignUp(bytes, kBlockAlign);
+    blocks_.push_back({static_cast<std::byte*>(upstream_->allocate(bytes, kBlockAlign)), bytes});
+    ++upstreamAllocations_;
+}
+
+void LinearArena::releaseBlocks()
+{
+    for (const Block& block : blocks_) {
+        upstream_->deallocate(block.data, block.size, kBlockAlign);
+    }
+    blocks_.clear();
+}
+
+void* LinearArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    bytes = std::max<std::size_t>(bytes, 1);
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            const std::size_t start = alignUp(offset_, alignment);
+            if (start + bytes <= blocks_[current_].size) {
+                offset_ = start + bytes;
+                highWater_ = std::max(highWater_, spent_ + offset_);
+                return blocks_[current_].data + start;
+            }
+            // Doesn't fit: the rest of this block goes unused until a reset
+            spent_ += blocks_[current_].size;
+            ++current_;
+            offset_ = 0;
+            continue;
+        }
+        // Out of blocks: chain one at least twice the last, so a frame that
+        // overflows needs few of them before the next reset merges them
+        const std::size_t last = blocks_.empty() ? 0 : blocks_.back().size;
+        addBlock(std::max(2 * last, bytes + alignment));
+    }
+}
+
+void LinearArena::rewind(const Marker& marker)
+{
+    // Back to empty: same as reset(), so scratch arenas coalesce too
+    if (marker.block == 0 && marker.offset == 0) {
+        reset();
+        return;
+    }
+    current_ = marker.block;
+    offset_ = marker.offset;
+    spent_ = marker.spent;
+}
+
+void LinearArena::reset()
+{
+    if (blocks_.size() > 1) {
+        const std::size_t total = capacity();
+        releaseBlocks();
+        addBlock(total);
+    }
+    current_ = 0;
+    offset_ = 0;
+    spent_ = 0;
+}
+
+FrameArena::FrameArena(std::size_t bytesPerFrame)
+        : arenas_{LinearArena(bytesPerFrame), LinearArena(bytesPerFrame)},
+          current_(&arenas_[0])
+{
+}
+
+void FrameArena::beginFrame()
+{
+    current_ = current_ == &arenas_[0] ? &arenas_[1] : &arenas_[0];
+    current_->reset();
+}
+
+LinearArena& scratchArena()
+{
+    static thread_local LinearArena arena;
+    return arena;
+}
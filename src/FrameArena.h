@@ -0,0 +1,127 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_FRAMEARENA_H
+#define TACTICGAME_FRAMEARENA_H
+
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for transient data, usable by any std::pmr container.
+// deallocate() does nothing; memory comes back all at once with reset() or
+// rewind(). Blocks are kept from one reset to the next, and a reset after
+// the arena had to chain extra blocks swaps them for one block that holds
+// the lot, so once the working set is known no call reaches the heap.
+//
+// Not thread-safe: one arena per thread (see scratchArena()).
+class LinearArena : public std::pmr::memory_resource
+{
+public:
+    explicit LinearArena(std::size_t initialBytes = 64 * 1024,
+                         std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~LinearArena() override;
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // A point to rewind() to; everything allocated after it is released
+    struct Marker
+    {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+        std::size_t spent = 0;
+    };
+    Marker mark() const { return {current_, offset_, spent_}; }
+    void rewind(const Marker& marker);
+
+    // Releases everything (and coalesces the blocks, see above); markers
+    // taken before it are void
+    void reset();
+
+    std::size_t bytesUsed() const { return spent_ + offset_; }
+    std::size_t highWater() const { return highWater_; }
+    std::size_t capacity() const;
+    // Blocks taken from upstream over the arena's lifetime; flat once warm
+    std::size_t upstreamAllocations() const { return upstreamAllocations_; }
+
+private:
+    struct Block
+    {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    std::pmr::memory_resource* upstream_;
+    std::vector<Block> blocks_;
+    std::size_t current_;   // block being bumped
+    std::size_t offset_;    // into blocks_[current_]
+    std::size_t spent_;     // bytes of the blocks before current_, tails included
+    std::size_t highWater_;
+    std::size_t upstreamAllocations_;
+
+    void addBlock(std::size_t bytes);
+    void releaseBlocks();
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Two arenas used on alternate frames. beginFrame() resets the one last
+// used two frames ago, so what a frame allocates stays valid until the end
+// of the next one (for data consumed a frame late).
+//
+//   arena.beginFrame();
+//   std::pmr::vector<float> xs(arena.resource());
+class FrameArena
+{
+public:
+    explicit FrameArena(std::size_t bytesPerFrame = 256 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void beginFrame();
+
+    std::pmr::memory_resource* resource() { return current_; }
+    const LinearArena& current() const { return *current_; }
+    const LinearArena& previous() const { return current_ == &arenas_[0] ? arenas_[1] : arenas_[0]; }
+
+private:
+    LinearArena arenas_[2];
+    LinearArena* current_;
+};
+
+// The calling thread's scratch arena, made on first use (job workers warm
+// theirs up front). For temporaries that die before the function that made
+// them returns: open a ScratchScope first and allocate from it.
+LinearArena& scratchArena();
+
+// Rewinds this thread's scratch arena to where it was when the scope
+// opened. Scopes nest, so a job can use scratch while the code that waited
+// on it holds its own. Containers on the scope must be declared after it.
+class ScratchScope
+{
+public:
+    ScratchScope()
+            : arena_(scratchArena()),
+              marker_(arena_.mark())
+    {
+    }
+    ~ScratchScope() { arena_.rewind(marker_); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    std::pmr::memory_resource* resource() { return &arena_; }
+
+private:
+    LinearArena& arena_;
+    LinearArena::Marker marker_;
+};
+
+
+#endif //TACTICGAME_FRAMEARENA_H
@@ -0,0 +1,75 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "FramePacer.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <thread>
+
+// glfwWaitEventsTimeout() needs a positive timeout
+static const double kMinWaitSeconds = 0.0005;
+
+FramePacer::FramePacer(const FramePacing& pacing)
+        : pacing_(pacing),
+          dirty_(true), // the first frame always draws
+          active_(false),
+          idle_(false),
+          drew_(true),
+          lastChange_(Clock::now()),
+          nextFrame_(Clock::now()),
+          drawn_(0),
+          skipped_(0)
+{
+}
+
+void FramePacer::waitForFrame()
+{
+    if (idle_ && pacing_.idleWait) {
+        glfwWaitEventsTimeout(pacing_.idleTimeout);
+        nextFrame_ = Clock::now();
+        return;
+    }
+
+    if (!drew_) {
+        // Nothing was submitted, so nothing paced the last iteration; wait
+        // for input (or the AI's orders) instead of spinning. The cap's
+        // deadline stays where it is, no frame was spent.
+        double timeout = pacing_.activeWait;
+        const double untilDeadline = std::chrono::duration<double>(nextFrame_ - Clock::now()).count();
+        if (pacing_.maxFps > 0.0 && untilDeadline > 0.0) {
+            timeout = untilDeadline;
+        }
+        glfwWaitEventsTimeout(std::max(timeout, kMinWaitSeconds));
+        return;
+    }
+
+    if (pacing_.maxFps > 0.0) {
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / pacing_.maxFps));
+        std::this_thread::sleep_until(nextFrame_);
+        // Late frames don't bank time for a burst afterwards
+        nextFrame_ = std::max(nextFrame_ + period, Clock::now());
+    }
+    glfwPollEvents();
+}
+
+bool FramePacer::finishUpdate()
+{
+    const Clock::time_point now = Clock::now();
+    if (dirty_ || active_) {
+        lastChange_ = now;
+    }
+    const auto linger = std::chrono::duration<double>(pacing_.lingerSeconds);
+    idle_ = !dirty_ && !active_ && now - lastChange_ >= linger;
+
+    const bool draw = dirty_;
+    drew_ = draw;
+    dirty_ = false;
+    active_ = false;
+    if (draw) {
+        ++drawn_;
+    } else {
+        ++skipped_;
+    }
+    return draw;
+}
@@ -0,0 +1,76 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_FRAMEPACER_H
+#define TACTICGAME_FRAMEPACER_H
+
+
+#include <chrono>
+#include <cstdint>
+
+struct FramePacing
+{
+    double maxFps = 0.0;         // frame cap; 0 = none beyond the swap interval
+    int swapInterval = 1;        // vblanks per swap, 0 = vsync off (RenderFrame::swapInterval)
+    bool idleWait = true;        // sleep in the event queue while nothing changes
+    double idleTimeout = 0.5;    // longest idle sleep, seconds
+    double lingerSeconds = 0.25; // keep full rate this long after the last change
+    double activeWait = 0.005;   // longest event wait after an iteration that drew nothing
+};
+
+// Decides, once per main-loop iteration, whether to wait and whether to draw.
+// Turn-based play spends most of its time on a static screen, so instead of
+// redrawing it forever the loop sleeps in glfwWaitEventsTimeout() until an
+// event arrives or the timeout passes, and only records a frame when
+// something marked it dirty. Any change (input, camera motion, units
+// moving) brings it straight back to full rate, where it stays for a short
+// linger so motion doesn't stutter between the two modes.
+//
+//   pacer.waitForFrame();       // sleeps or polls, then handles events
+//   ... update, markDirty() / markActive() ...
+//   if (pacer.finishUpdate()) { record and submit the frame }
+class FramePacer
+{
+public:
+    explicit FramePacer(const FramePacing& pacing = FramePacing{});
+
+    const FramePacing& pacing() const { return pacing_; }
+    void setPacing(const FramePacing& pacing) { pacing_ = pacing; }
+
+    // Processes window events: sleeps in the event queue if the last
+    // iteration was idle; waits for an event (up to the frame cap's
+    // deadline, else activeWait) if it was active but drew nothing, since
+    // no swap blocked it; otherwise waits out the frame cap and polls
+    void waitForFrame();
+
+    // Something visible changed; this iteration draws
+    void markDirty() { dirty_ = true; }
+    // Something will change without an event to wake us (AI thinking,
+    // textures streaming): keep iterating at full rate, draw only if dirty
+    void markActive() { active_ = true; }
+
+    // Ends the update half of the iteration; true if it should draw.
+    // Clears the marks for the next iteration.
+    bool finishUpdate();
+
+    bool idle() const { return idle_; }
+    std::uint64_t framesDrawn() const { return drawn_; }
+    std::uint64_t framesSkipped() const { return skipped_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    FramePacing pacing_;
+    bool dirty_;
+    bool active_;
+    bool idle_;
+    bool drew_; // the last finishUpdate() said to draw
+    Clock::time_point lastChange_;
+    Clock::time_point nextFrame_; // frame cap deadline
+    std::uint64_t drawn_;
+    std::uint64_t skipped_;
+};
+
+
+#endif //TACTICGAME_FRAMEPACER_H
@@ -0,0 +1,30 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "FrameUniforms.h"
+#include "StreamBuffer.h"
+#include <glad/glad.h>
+#include <cstring>
+
+FrameUniformBuffer::FrameUniformBuffer(StreamBuffer& stream)
+        : stream_(stream),
+          offsetAlignment_(256)
+{
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment_);
+    if (offsetAlignment_ <= 0) {
+        offsetAlignment_ = 256;
+    }
+}
+
+void FrameUniformBuffer::update(const FrameData& data)
+{
+    StreamAllocation allocation = stream_.allocate(sizeof(FrameData), (std::size_t)offsetAlignment_);
+    if (!allocation.valid()) {
+        return;
+    }
+    std::memcpy(allocation.ptr, &data, sizeof(FrameData));
+    stream_.commit(allocation);
+    glBindBufferRange(GL_UNIFORM_BUFFER, kFrameUniformBinding, stream_.id(),
+                      (GLintptr)allocation.offset, sizeof(FrameData));
+}
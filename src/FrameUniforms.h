@@ -0,0 +1,59 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_FRAMEUNIFORMS_H
+#define TACTICGAME_FRAMEUNIFORMS_H
+
+
+#include <glm/glm.hpp>
+
+// Fixed binding point for the per-frame uniform block. Every program built
+// through Shader that declares "FrameData" is bound to it automatically.
+constexpr unsigned int kFrameUniformBinding = 0;
+constexpr const char* kFrameUniformBlockName = "FrameData";
+
+// CPU mirror of the std140 block below. Only mat4/vec4 members, so the
+// C++ layout matches std140 without padding tricks.
+//
+//   layout(std140) uniform FrameData {
+//       mat4 view;
+//       mat4 projection;
+//       vec4 viewPos;     // xyz
+//       vec4 lightPos;    // w = 1: xyz = position; w = 0: xyz = direction toward the light
+//       vec4 lightColor;  // rgb
+//       vec4 skyColor;    // rgb = colour, a = strength
+//   };
+struct FrameData
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec4 viewPos;
+    glm::vec4 lightPos;
+    glm::vec4 lightColor;
+    glm::vec4 skyColor;
+};
+static_assert(sizeof(FrameData) == 2 * 64 + 4 * 16, "FrameData must match the std140 layout");
+
+class StreamBuffer;
+
+// Feeds kFrameUniformBinding; one update per frame. Each frame's block is
+// written into the stream ring and bound as a range, so updating never
+// waits for the GPU to finish with last frame's copy.
+class FrameUniformBuffer
+{
+public:
+    explicit FrameUniformBuffer(StreamBuffer& stream);
+
+    FrameUniformBuffer(const FrameUniformBuffer&) = delete;
+    FrameUniformBuffer& operator=(const FrameUniformBuffer&) = delete;
+
+    void update(const FrameData& data);
+
+private:
+    StreamBuffer& stream_;
+    int offsetAlignment_; // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+};
+
+
+#endif //TACTICGAME_FRAMEUNIFORMS_H
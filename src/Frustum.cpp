@@ -0,0 +1,63 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Frustum.h"
+
+Frustum::Frustum(const glm::mat4& viewProjection)
+{
+    set(viewProjection);
+}
+
+void Frustum::set(const glm::mat4& m)
+{
+    // Gribb/Hartmann: each plane is row 3 +/- row k of the clip matrix
+    // (glm is column-major, so row r is m[0][r], m[1][r], m[2][r], m[3][r])
+    auto row = [&m](int r) { return glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]); };
+    const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    planes_[0] = r3 + r0; // left
+    planes_[1] = r3 - r0; // right
+    planes_[2] = r3 + r1; // bottom
+    planes_[3] = r3 - r1; // top
+    planes_[4] = r3 + r2; // near
+    planes_[5] = r3 - r2; // far
+
+    for (glm::vec4& p : planes_)
+    {
+        float len = glm::length(glm::vec3(p));
+        if (len > 0.0f) {
+            p = p / len;
+        }
+    }
+}
+
+CullResult Frustum::classifyAABB(const glm::vec3& min, const glm::vec3& max) const
+{
+    CullResult result = CullResult::Inside;
+    for (const glm::vec4& p : planes_)
+    {
+        // Corner furthest along the plane normal (p-vertex) and its opposite
+        glm::vec3 pos(p.x >= 0 ? max.x : min.x, p.y >= 0 ? max.y : min.y, p.z >= 0 ? max.z : min.z);
+        glm::vec3 neg(p.x >= 0 ? min.x : max.x, p.y >= 0 ? min.y : max.y, p.z >= 0 ? min.z : max.z);
+
+        if (glm::dot(glm::vec3(p), pos) + p.w < 0.0f) {
+            return CullResult::Outside;
+        }
+        if (glm::dot(glm::vec3(p), neg) + p.w < 0.0f) {
+            result = CullResult::Intersects;
+        }
+    }
+    return result;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const
+{
+    for (const glm::vec4& p : planes_)
+    {
+        if (glm::dot(glm::vec3(p), center) + p.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,43 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_FRUSTUM_H
+#define TACTICGAME_FRUSTUM_H
+
+
+#include <glm/glm.hpp>
+
+enum class CullResult
+{
+    Outside,
+    Intersects,
+    Inside
+};
+
+// Six planes pulled from a view-projection matrix. Works the same for the
+// isometric glm::ortho box and a perspective frustum.
+class Frustum
+{
+public:
+    Frustum() = default;
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    void set(const glm::mat4& viewProjection);
+
+    CullResult classifyAABB(const glm::vec3& min, const glm::vec3& max) const;
+    bool intersectsAABB(const glm::vec3& min, const glm::vec3& max) const
+    {
+        return classifyAABB(min, max) != CullResult::Outside;
+    }
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+
+    // left, right, bottom, top, near, far; xyz = inward normal, w = distance
+    const glm::vec4& plane(int i) const { return planes_[i]; }
+
+private:
+    glm::vec4 planes_[6];
+};
+
+
+#endif //TACTICGAME_FRUSTUM_H
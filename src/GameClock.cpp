@@ -0,0 +1,50 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "GameClock.h"
+
+FrameClock::FrameClock(double maxFrameSeconds)
+        : previous_(std::chrono::steady_clock::now()),
+          maxFrame_(maxFrameSeconds),
+          last_(0.0)
+{
+}
+
+double FrameClock::tick()
+{
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - previous_).count();
+    previous_ = now;
+
+    last_ = seconds > maxFrame_ ? maxFrame_ : seconds;
+    return last_;
+}
+
+FixedTimestep::FixedTimestep(double stepSeconds, int maxStepsPerFrame)
+        : step_(stepSeconds),
+          maxSteps_(maxStepsPerFrame),
+          accumulator_(0.0),
+          ticks_(0)
+{
+}
+
+int FixedTimestep::advance(double frameSeconds)
+{
+    accumulator_ += frameSeconds;
+
+    int steps = 0;
+    while (accumulator_ >= step_ && steps < maxSteps_)
+    {
+        accumulator_ -= step_;
+        ++steps;
+    }
+
+    // Can't keep up: drop the backlog instead of spiralling
+    if (steps == maxSteps_ && accumulator_ >= step_) {
+        accumulator_ = 0.0;
+    }
+
+    ticks_ += steps;
+    return steps;
+}
@@ -0,0 +1,53 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_GAMECLOCK_H
+#define TACTICGAME_GAMECLOCK_H
+
+
+#include <chrono>
+#include <cstdint>
+
+// Wall-clock frame timer (no GLFW dependency, so headless runs can use it)
+class FrameClock
+{
+public:
+    // Frames longer than this (breakpoints, window drags) are clamped
+    explicit FrameClock(double maxFrameSeconds = 0.25);
+
+    // Seconds since the previous call (or construction)
+    double tick();
+
+    double lastFrameSeconds() const { return last_; }
+
+private:
+    std::chrono::steady_clock::time_point previous_;
+    double maxFrame_;
+    double last_;
+};
+
+// Accumulates real frame time and hands out whole simulation ticks of a
+// fixed length. Rendering interpolates between the last two ticks with alpha().
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(double stepSeconds, int maxStepsPerFrame = 8);
+
+    // Add a frame's worth of time; returns how many ticks to run now
+    int advance(double frameSeconds);
+
+    double step() const { return step_; }
+    // Fraction of the next tick already elapsed, in [0, 1)
+    float alpha() const { return (float)(accumulator_ / step_); }
+    std::uint64_t tickCount() const { return ticks_; }
+
+private:
+    double step_;
+    int maxSteps_;
+    double accumulator_;
+    std::uint64_t ticks_;
+};
+
+
+#endif //TACTICGAME_GAMECLOCK_H
@@ -0,0 +1,148 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "GridRenderer.h"
+#include "TileMap.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstddef>
+
+GridRenderer::GridRenderer(unsigned int cubeVAO, int indexCount)
+        : vao_(cubeVAO),
+          instanceVBO_(0),
+          indexCount_(indexCount),
+          width_(0),
+          depth_(0),
+          dirty_(false)
+{
+    glGenBuffers(1, &instanceVBO_);
+
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO_);
+
+    // Instance attribute: xyz = tile offset, w = tile type
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(TileInstance), (void*)offsetof(TileInstance, offset));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    glBindVertexArray(0);
+}
+
+GridRenderer::~GridRenderer()
+{
+    glDeleteBuffers(1, &instanceVBO_);
+}
+
+void GridRenderer::build(const TileMap& map)
+{
+    width_ = map.width();
+    depth_ = map.depth();
+    instances_.clear();
+    instances_.reserve((size_t)map.width() * map.depth());
+    slots_.assign((size_t)map.width() * map.depth(), 0);
+    chunkStart_.assign((size_t)map.chunkCount() + 1, 0);
+
+    // Chunk-major order so each map chunk is one contiguous instance range
+    // that culling can draw (or skip) as a unit
+    for (int cz = 0; cz < map.chunksZ(); ++cz) {
+        for (int cx = 0; cx < map.chunksX(); ++cx) {
+            chunkStart_[cz * map.chunksX() + cx] = (int)instances_.size();
+
+            const int iEnd = std::min((cx + 1) * kChunkSize, map.width());
+            const int jEnd = std::min((cz + 1) * kChunkSize, map.depth());
+            for (int i = cx * kChunkSize; i < iEnd; ++i) {
+                for (int j = cz * kChunkSize; j < jEnd; ++j) {
+                    // Same layout as the old per-cube loop: tile (i, j) sits at (i - n/2, 0, j - n/2)
+                    TileInstance tile{};
+                    tile.offset   = map.tileCenter(i, j);
+                    tile.tileType = (float)map.type(i, j);
+                    // Holes still take a slot so setTileType() can find (i, j);
+                    // push them far below the board instead
+                    if (!map.hasTile(i, j)) {
+                        tile.offset.y = -1e6f;
+                    }
+                    slots_[(size_t)i * depth_ + j] = (int)instances_.size();
+                    instances_.push_back(tile);
+                }
+            }
+        }
+    }
+    chunkStart_.back() = (int)instances_.size();
+    dirty_ = true;
+}
+
+void GridRenderer::setTileType(int i, int j, int type)
+{
+    if (i < 0 || j < 0 || i >= width_ || j >= depth_) {
+        return;
+    }
+    instances_[slots_[(size_t)i * depth_ + j]].tileType = (float)type;
+    dirty_ = true;
+}
+
+void GridRenderer::draw()
+{
+    if (instances_.empty()) {
+        return;
+    }
+    if (dirty_) {
+        upload();
+    }
+
+    glBindVertexArray(vao_);
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, 0, (GLsizei)instances_.size());
+}
+
+int GridRenderer::draw(const std::vector<int>& visibleChunks, long long* instancesDrawn)
+{
+    if (instances_.empty() || visibleChunks.empty()) {
+        return 0;
+    }
+    if (dirty_) {
+        upload();
+    }
+
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO_);
+
+    // GL 3.3 has no base-instance draw, so each run of adjacent visible
+    // chunks re-points attribute 3 at its first instance instead
+    int draws = 0;
+    size_t k = 0;
+    while (k < visibleChunks.size()) {
+        const int first = visibleChunks[k];
+        int last = first;
+        while (k + 1 < visibleChunks.size() && visibleChunks[k + 1] == last + 1) {
+            ++k;
+            ++last;
+        }
+        ++k;
+
+        const int begin = chunkStart_[first];
+        const int count = chunkStart_[last + 1] - begin;
+        if (count == 0) {
+            continue;
+        }
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(TileInstance),
+                              (void*)(begin * sizeof(TileInstance) + offsetof(TileInstance, offset)));
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, 0, count);
+        ++draws;
+        if (instancesDrawn) {
+            *instancesDrawn += count;
+        }
+    }
+
+    // Leave the VAO pointing at the start for draw()
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(TileInstance), (void*)offsetof(TileInstance, offset));
+    return draws;
+}
+
+void GridRenderer::upload()
+{
+    // The board only changes on edits, so a full re-specify is fine here
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO_);
+    glBufferData(GL_ARRAY_BUFFER, instances_.size() * sizeof(TileInstance),
+                 instances_.data(), GL_STATIC_DRAW);
+    dirty_ = false;
+}
@@ -0,0 +1,64 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_GRIDRENDERER_H
+#define TACTICGAME_GRIDRENDERER_H
+
+
+#include <vector>
+#include <glm/glm.hpp>
+
+class TileMap;
+
+// One entry per tile in the instance VBO (vertex attribute location 3)
+struct TileInstance
+{
+    glm::vec3 offset;   // tile centre in world space
+    float     tileType; // material index, read by the shader
+};
+
+// Draws the whole board with a single glDrawElementsInstanced call.
+// The cube VAO keeps its per-vertex attributes (0..2); this class adds a
+// per-instance attribute on location 3 that replaces the per-tile "model" upload.
+class GridRenderer
+{
+public:
+    GridRenderer(unsigned int cubeVAO, int indexCount);
+    ~GridRenderer();
+
+    GridRenderer(const GridRenderer&) = delete;
+    GridRenderer& operator=(const GridRenderer&) = delete;
+
+    // One unit cube per tile that exists in the map (heights are ignored;
+    // MapChunks is the path that handles uneven terrain)
+    void build(const TileMap& map);
+
+    void setTileType(int i, int j, int type);
+
+    // Uploads the instance buffer if it changed, then draws every tile
+    void draw();
+    // Only the given map chunks (ascending indices, as SpatialGrid returns
+    // them); adjacent chunks merge into one draw. Returns the draw count.
+    int draw(const std::vector<int>& visibleChunks, long long* instancesDrawn = nullptr);
+
+    int instanceCount() const { return (int)instances_.size(); }
+    int indexCount() const { return indexCount_; }
+
+private:
+    unsigned int vao_;
+    unsigned int instanceVBO_;
+    int indexCount_;
+    int width_;
+    int depth_;
+
+    std::vector<TileInstance> instances_;
+    std::vector<int> slots_;      // tile (i * depth + j) -> instance index
+    std::vector<int> chunkStart_; // first instance of each chunk, plus end sentinel
+    bool dirty_;
+
+    void upload();
+};
+
+
+#endif //TACTICGAME_GRIDRENDERER_H
@@ -0,0 +1,147 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "InstanceKernels.h"
+
+// TACTICGAME_SCALAR_KERNELS (CMake option TACTICGAME_SIMD=OFF) forces the
+// reference path; otherwise use the widest instruction set we're built for
+#if !defined(TACTICGAME_SCALAR_KERNELS)
+#   if defined(__AVX__)
+#       define TACTICGAME_KERNEL_AVX 1
+#       include <immintrin.h>
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define TACTICGAME_KERNEL_SSE 1
+#       include <xmmintrin.h>
+#   elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#       define TACTICGAME_KERNEL_NEON 1
+#       include <arm_neon.h>
+#   endif
+#endif
+
+// Reference version, also used for the tail of every SIMD batch
+static void buildScalar(const TransformStreams& in, size_t begin, size_t end,
+                        float* out, size_t stride)
+{
+    for (size_t k = begin; k < end; ++k)
+    {
+        const float s = in.scale[k];
+        const float a = s * in.facingZ[k]; // s * cos(yaw)
+        const float b = s * in.facingX[k]; // s * sin(yaw)
+        float* dst = out + k * stride;
+        dst[0]  = a;     dst[1]  = 0.0f; dst[2]  = b;    dst[3]  = in.x[k];
+        dst[4]  = 0.0f;  dst[5]  = s;    dst[6]  = 0.0f; dst[7]  = in.y[k];
+        dst[8]  = -b;    dst[9]  = 0.0f; dst[10] = a;    dst[11] = in.z[k];
+    }
+}
+
+#if defined(TACTICGAME_KERNEL_SSE) || defined(TACTICGAME_KERNEL_AVX)
+// Four instances with their columns in lanes: transpose each row group so
+// every instance's row lands contiguously, then store it
+static inline void storeFourSSE(__m128 a, __m128 b, __m128 s,
+                                __m128 x, __m128 y, __m128 z,
+                                float* out, size_t stride)
+{
+    const __m128 zero = _mm_setzero_ps();
+    __m128 r0c0 = a,    r0c1 = zero, r0c2 = b,    r0c3 = x;
+    __m128 r1c0 = zero, r1c1 = s,    r1c2 = zero, r1c3 = y;
+    __m128 r2c0 = _mm_sub_ps(zero, b), r2c1 = zero, r2c2 = a, r2c3 = z;
+    _MM_TRANSPOSE4_PS(r0c0, r0c1, r0c2, r0c3);
+    _MM_TRANSPOSE4_PS(r1c0, r1c1, r1c2, r1c3);
+    _MM_TRANSPOSE4_PS(r2c0, r2c1, r2c2, r2c3);
+
+    // After the transpose, register n holds instance n's row
+    const __m128 row0[4] = {r0c0, r0c1, r0c2, r0c3};
+    const __m128 row1[4] = {r1c0, r1c1, r1c2, r1c3};
+    const __m128 row2[4] = {r2c0, r2c1, r2c2, r2c3};
+    for (int n = 0; n < 4; ++n)
+    {
+        float* dst = out + n * stride;
+        _mm_storeu_ps(dst,     row0[n]);
+        _mm_storeu_ps(dst + 4, row1[n]);
+        _mm_storeu_ps(dst + 8, row2[n]);
+    }
+}
+#endif
+
+void buildInstanceTransforms(const TransformStreams& in, size_t count,
+                             float* out, size_t strideFloats)
+{
+    size_t k = 0;
+
+#if defined(TACTICGAME_KERNEL_AVX)
+    // Eight lanes of arithmetic, then two four-wide transposes
+    for (; k + 8 <= count; k += 8)
+    {
+        const __m256 s  = _mm256_loadu_ps(in.scale + k);
+        const __m256 a  = _mm256_mul_ps(s, _mm256_loadu_ps(in.facingZ + k));
+        const __m256 b  = _mm256_mul_ps(s, _mm256_loadu_ps(in.facingX + k));
+        const __m256 x  = _mm256_loadu_ps(in.x + k);
+        const __m256 y  = _mm256_loadu_ps(in.y + k);
+        const __m256 z  = _mm256_loadu_ps(in.z + k);
+
+        storeFourSSE(_mm256_castps256_ps128(a), _mm256_castps256_ps128(b),
+                     _mm256_castps256_ps128(s), _mm256_castps256_ps128(x),
+                     _mm256_castps256_ps128(y), _mm256_castps256_ps128(z),
+                     out + k * strideFloats, strideFloats);
+        storeFourSSE(_mm256_extractf128_ps(a, 1), _mm256_extractf128_ps(b, 1),
+                     _mm256_extractf128_ps(s, 1), _mm256_extractf128_ps(x, 1),
+                     _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1),
+                     out + (k + 4) * strideFloats, strideFloats);
+    }
+#endif
+
+#if defined(TACTICGAME_KERNEL_SSE) || defined(TACTICGAME_KERNEL_AVX)
+    for (; k + 4 <= count; k += 4)
+    {
+        const __m128 s = _mm_loadu_ps(in.scale + k);
+        const __m128 a = _mm_mul_ps(s, _mm_loadu_ps(in.facingZ + k));
+        const __m128 b = _mm_mul_ps(s, _mm_loadu_ps(in.facingX + k));
+        storeFourSSE(a, b, s,
+                     _mm_loadu_ps(in.x + k), _mm_loadu_ps(in.y + k), _mm_loadu_ps(in.z + k),
+                     out + k * strideFloats, strideFloats);
+    }
+#endif
+
+#if defined(TACTICGAME_KERNEL_NEON)
+    for (; k + 4 <= count; k += 4)
+    {
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const float32x4_t s = vld1q_f32(in.scale + k);
+        const float32x4_t a = vmulq_f32(s, vld1q_f32(in.facingZ + k));
+        const float32x4_t b = vmulq_f32(s, vld1q_f32(in.facingX + k));
+
+        // vst4q interleaves the four columns, i.e. writes the rows of four
+        // instances back to back; stage them and scatter by stride
+        const float32x4x4_t row0 = {{a, zero, b, vld1q_f32(in.x + k)}};
+        const float32x4x4_t row1 = {{zero, s, zero, vld1q_f32(in.y + k)}};
+        const float32x4x4_t row2 = {{vnegq_f32(b), zero, a, vld1q_f32(in.z + k)}};
+        float rows[3][16];
+        vst4q_f32(rows[0], row0);
+        vst4q_f32(rows[1], row1);
+        vst4q_f32(rows[2], row2);
+        for (int n = 0; n < 4; ++n)
+        {
+            float* dst = out + (k + n) * strideFloats;
+            vst1q_f32(dst,     vld1q_f32(rows[0] + n * 4));
+            vst1q_f32(dst + 4, vld1q_f32(rows[1] + n * 4));
+            vst1q_f32(dst + 8, vld1q_f32(rows[2] + n * 4));
+        }
+    }
+#endif
+
+    buildScalar(in, k, count, out, strideFloats);
+}
+
+const char* instanceKernelName()
+{
+#if defined(TACTICGAME_KERNEL_AVX)
+    return "avx";
+#elif defined(TACTICGAME_KERNEL_SSE)
+    return "sse";
+#elif defined(TACTICGAME_KERNEL_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,39 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_INSTANCEKERNELS_H
+#define TACTICGAME_INSTANCEKERNELS_H
+
+
+#include <cstddef>
+
+// Structure-of-arrays inputs for buildInstanceTransforms. Every pointer
+// holds `count` floats. facing is a unit XZ direction (the yaw as a
+// vector, so the kernel needs no trig); (0, 1) faces +Z.
+struct TransformStreams
+{
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+    const float* scale = nullptr;
+    const float* facingX = nullptr;
+    const float* facingZ = nullptr;
+};
+
+// One transform is a row-major mat3x4: three vec4 rows of
+// (rotation * scale | translation), transposed back to a mat4 in the shader
+constexpr size_t kTransformFloats = 12;
+
+// Writes count transforms to out, one every strideFloats floats
+// (>= kTransformFloats; spare floats are left untouched). out can be
+// mapped GL memory: it is only written, never read, and needs no alignment.
+// The SIMD flavour (AVX, SSE, NEON or scalar) is picked at build time.
+void buildInstanceTransforms(const TransformStreams& in, size_t count,
+                             float* out, size_t strideFloats);
+
+// Which flavour was compiled in: "avx", "sse", "neon" or "scalar"
+const char* instanceKernelName();
+
+
+#endif //TACTICGAME_INSTANCEKERNELS_H
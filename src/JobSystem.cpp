@@ -0,0 +1,158 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "JobSystem.h"
+#include "FrameArena.h"
+
+// Index of the pool worker running on this thread, -1 on any other thread
+static thread_local int tWorkerIndex = -1;
+static thread_local const JobSystem* tWorkerPool = nullptr;
+
+JobSystem::JobSystem(unsigned workerCount)
+        : queued_(0),
+          stop_(false)
+{
+    if (workerCount == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+    workers_.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Start only once every deque exists, since workers steal from each other
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers_[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+void JobSystem::submit(std::function<void()> job, JobCounter* counter)
+{
+    if (counter) {
+        counter->pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job entry{std::move(job), counter};
+    if (tWorkerPool == this) {
+        Worker& self = *workers_[tWorkerIndex];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        self.jobs.push_back(std::move(entry));
+    } else {
+        std::lock_guard<std::mutex> lock(injectMutex_);
+        injected_.push_back(std::move(entry));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Lock so a worker between its last check and its wait can't miss this
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+bool JobSystem::takeJob(int self, Job& out)
+{
+    if (queued_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    if (self >= 0) {
+        Worker& own = *workers_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            out = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(injectMutex_);
+        if (!injected_.empty()) {
+            out = std::move(injected_.front());
+            injected_.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal, starting just past ourselves so thieves spread out
+    const int count = (int)workers_.size();
+    for (int k = 1; k <= count; ++k) {
+        const int victim = ((self < 0 ? 0 : self) + k) % count;
+        if (victim == self) {
+            continue;
+        }
+        Worker& other = *workers_[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.jobs.empty()) {
+            out = std::move(other.jobs.front());
+            other.jobs.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::run(Job& job)
+{
+    {
+        // Whatever scratch the job leaves behind goes with it
+        ScratchScope scratch;
+        job.fn();
+    }
+    if (job.counter) {
+        job.counter->pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void JobSystem::workerLoop(unsigned index)
+{
+    tWorkerIndex = (int)index;
+    tWorkerPool = this;
+    // First block of this worker's scratch arena, before any job needs it
+    scratchArena();
+
+    Job job;
+    for (;;) {
+        if (takeJob((int)index, job)) {
+            run(job);
+            job = Job{};
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this]() { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    const int self = tWorkerPool == this ? tWorkerIndex : -1;
+    Job job;
+    while (!counter.done()) {
+        if (takeJob(self, job)) {
+            run(job);
+            job = Job{};
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
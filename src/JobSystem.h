@@ -0,0 +1,115 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_JOBSYSTEM_H
+#define TACTICGAME_JOBSYSTEM_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tracks a group of jobs. Pass the same counter to several submit() calls,
+// then wait() on it or poll done() from a frame loop.
+class JobCounter
+{
+public:
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending_{0};
+};
+
+// Work-stealing thread pool. Every worker owns a deque: it pushes and pops
+// its own jobs at the back (newest first, cache-warm) and, when empty,
+// steals the oldest job from the front of another worker's deque. Jobs
+// submitted from outside the pool go through a shared injection queue.
+//
+// Deques are short and guarded by their own mutex; contention only happens
+// on a steal, which is rare once a worker has work of its own.
+//
+// Jobs run inside a ScratchScope, so they can allocate temporaries from
+// scratchArena() and leave nothing behind on the worker.
+class JobSystem
+{
+public:
+    // 0 = one per hardware thread, minus the main thread
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(std::function<void()> job, JobCounter* counter = nullptr);
+
+    // Blocks until the counter's jobs are done, running queued jobs
+    // (anyone's) meanwhile instead of sleeping
+    void wait(JobCounter& counter);
+
+    // Calls fn(begin, end) over [0, count) in ranges of about `grain`,
+    // spread across the pool, and returns when all ranges are done.
+    // fn runs concurrently and must be safe to call that way.
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, Fn&& fn)
+    {
+        JobCounter counter;
+        parallelForAsync(count, grain, std::forward<Fn>(fn), counter);
+        wait(counter);
+    }
+
+    // As parallelFor(), but returns immediately; fn is copied into the jobs
+    // and `counter` reports completion
+    template <typename Fn>
+    void parallelForAsync(size_t count, size_t grain, Fn fn, JobCounter& counter)
+    {
+        grain = std::max<size_t>(grain, 1);
+        auto shared = std::make_shared<Fn>(std::move(fn));
+        for (size_t begin = 0; begin < count; begin += grain) {
+            const size_t end = std::min(count, begin + grain);
+            submit([shared, begin, end]() { (*shared)(begin, end); }, &counter);
+        }
+    }
+
+    unsigned workerCount() const { return (unsigned)workers_.size(); }
+
+private:
+    struct Job
+    {
+        std::function<void()> fn;
+        JobCounter* counter = nullptr;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex injectMutex_;
+    std::deque<Job> injected_;
+
+    // Sleep/wake for idle workers
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<int> queued_;
+    std::atomic<bool> stop_;
+
+    void workerLoop(unsigned index);
+    // Own deque (back), then the injection queue, then steal (front)
+    bool takeJob(int self, Job& out);
+    void run(Job& job);
+};
+
+
+#endif //TACTICGAME_JOBSYSTEM_H
@@ -0,0 +1,241 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "MapChunks.h"
+#include "MapFile.h"
+#include "TileMap.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+static std::uint16_t quantize(float offset)
+{
+    const long q = std::lround(offset / kChunkPositionStep);
+    return (std::uint16_t)std::clamp(q, 0L, 65535L);
+}
+
+// Appends the quad origin, origin+u, origin+u+v, origin+v (CCW seen from
+// the side `normal` points to), quantized against `chunkOrigin`
+static void emitQuad(ChunkGeometry& out, const glm::vec3& chunkOrigin,
+                     const glm::vec3& origin, const glm::vec3& u, const glm::vec3& v,
+                     const glm::vec3& normal, float vRepeat, int layer)
+{
+    const unsigned int base = (unsigned int)out.vertices.size();
+    const glm::vec3 corners[4] = { origin, origin + u, origin + u + v, origin + v };
+    const float uvs[4][2] = { {0.f, 0.f}, {1.f, 0.f}, {1.f, vRepeat}, {0.f, vRepeat} };
+    const std::uint32_t packedNormal = packNormal(normal);
+
+    for (int k = 0; k < 4; ++k)
+    {
+        const glm::vec3 p = corners[k] - chunkOrigin;
+        ChunkVertex vertex;
+        vertex.position[0] = quantize(p.x);
+        vertex.position[1] = quantize(p.y);
+        vertex.position[2] = quantize(p.z);
+        vertex.layer       = (std::uint16_t)layer;
+        vertex.normal      = packedNormal;
+        vertex.uv[0]       = packHalf(uvs[k][0]);
+        vertex.uv[1]       = packHalf(uvs[k][1]);
+        out.vertices.push_back(vertex);
+    }
+    out.indices.insert(out.indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+}
+
+void ChunkGeometry::clear()
+{
+    vertices.clear();
+    indices.clear();
+    boundsMin = glm::vec3(0.0f);
+    boundsMax = glm::vec3(0.0f);
+}
+
+MapChunks::MapChunks(const TileMap& map)
+        : map_(map),
+          chunks_((size_t)map.chunkCount())
+{
+    update();
+}
+
+MapChunks::MapChunks(const TileMap& map, const MapFile& baked)
+        : map_(map),
+          chunks_((size_t)map.chunkCount())
+{
+    if (baked.hasBakedChunks() && baked.width() == map.width() && baked.depth() == map.depth()) {
+        for (int cz = 0; cz < map_.chunksZ(); ++cz)
+        {
+            for (int cx = 0; cx < map_.chunksX(); ++cx)
+            {
+                const int index = cz * map_.chunksX() + cx;
+                const MapChunkRecord& record = baked.chunk(index);
+                ChunkMesh& mesh = chunks_[index];
+                upload(mesh, baked.chunkVertices(index), record.vertexCount,
+                       baked.chunkIndices(index), record.indexCount);
+                mesh.builtRevision = map_.chunkRevision(cx, cz);
+                mesh.origin = chunkOrigin(map_, cx, cz);
+                mesh.boundsMin = glm::vec3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]);
+                mesh.boundsMax = glm::vec3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]);
+            }
+        }
+    }
+    // Anything the file didn't cover (or a file without meshes) is baked here
+    update();
+}
+
+MapChunks::~MapChunks()
+{
+    for (ChunkMesh& mesh : chunks_)
+    {
+        glDeleteVertexArrays(1, &mesh.VAO);
+        glDeleteBuffers(1, &mesh.VBO);
+        glDeleteBuffers(1, &mesh.EBO);
+    }
+}
+
+int MapChunks::update()
+{
+    int rebuilt = 0;
+    for (int cz = 0; cz < map_.chunksZ(); ++cz)
+    {
+        for (int cx = 0; cx < map_.chunksX(); ++cx)
+        {
+            ChunkMesh& mesh = chunks_[cz * map_.chunksX() + cx];
+            if (mesh.builtRevision != map_.chunkRevision(cx, cz)) {
+                buildChunk(cx, cz, mesh);
+                ++rebuilt;
+            }
+        }
+    }
+    return rebuilt;
+}
+
+void MapChunks::draw() const
+{
+    for (int i = 0; i < chunkCount(); ++i)
+    {
+        drawChunk(i);
+    }
+}
+
+void MapChunks::drawChunk(int index) const
+{
+    const ChunkMesh& mesh = chunks_[index];
+    if (mesh.indexCount == 0) {
+        return;
+    }
+    glBindVertexArray(mesh.VAO);
+    glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
+}
+
+int MapChunks::triangleCount() const
+{
+    int total = 0;
+    for (const ChunkMesh& mesh : chunks_)
+    {
+        total += mesh.indexCount / 3;
+    }
+    return total;
+}
+
+glm::vec3 MapChunks::chunkOrigin(const TileMap& map, int cx, int cz)
+{
+    const glm::vec3 c = map.tileCenter(cx * kChunkSize, cz * kChunkSize);
+    return glm::vec3(c.x - 0.5f, -0.5f, c.z - 0.5f);
+}
+
+void MapChunks::bakeChunk(const TileMap& map, int cx, int cz, ChunkGeometry& out)
+{
+    out.clear();
+    const glm::vec3 origin = chunkOrigin(map, cx, cz);
+
+    const float bottom = -0.5f;
+    glm::vec3 boundsMin(1e30f);
+    glm::vec3 boundsMax(-1e30f);
+
+    const int iEnd = std::min((cx + 1) * kChunkSize, map.width());
+    const int jEnd = std::min((cz + 1) * kChunkSize, map.depth());
+    for (int i = cx * kChunkSize; i < iEnd; ++i)
+    {
+        for (int j = cz * kChunkSize; j < jEnd; ++j)
+        {
+            if (!map.hasTile(i, j)) {
+                continue;
+            }
+
+            const glm::vec3 c = map.tileCenter(i, j);
+            const float x0 = c.x - 0.5f, x1 = c.x + 0.5f;
+            const float z0 = c.z - 0.5f, z1 = c.z + 0.5f;
+            const float top = map.topY(i, j);
+
+            const int layer = map.type(i, j);
+
+            // Top face, always visible
+            emitQuad(out, origin, {x0, top, z1}, {1, 0, 0}, {0, 0, -1}, {0, 1, 0}, 1.0f, layer);
+
+            // Sides: only the part above the neighbour's top (a hole or the
+            // map edge exposes the whole column)
+            auto side = [&](int ni, int nj, const glm::vec3& faceOrigin, const glm::vec3& u, const glm::vec3& normal) {
+                float from = map.hasTile(ni, nj) ? map.topY(ni, nj) : bottom;
+                if (from >= top) {
+                    return;
+                }
+                glm::vec3 o(faceOrigin.x, from, faceOrigin.z);
+                emitQuad(out, origin, o, u, {0, top - from, 0}, normal, top - from, layer);
+            };
+            side(i + 1, j, {x1, 0, z1}, {0, 0, -1}, { 1, 0, 0});
+            side(i - 1, j, {x0, 0, z0}, {0, 0,  1}, {-1, 0, 0});
+            side(i, j + 1, {x0, 0, z1}, { 1, 0, 0}, {0, 0,  1});
+            side(i, j - 1, {x1, 0, z0}, {-1, 0, 0}, {0, 0, -1});
+
+            boundsMin = glm::min(boundsMin, glm::vec3(x0, bottom, z0));
+            boundsMax = glm::max(boundsMax, glm::vec3(x1, top, z1));
+        }
+    }
+
+    if (!out.indices.empty()) {
+        out.boundsMin = boundsMin;
+        out.boundsMax = boundsMax;
+    }
+}
+
+void MapChunks::buildChunk(int cx, int cz, ChunkMesh& mesh)
+{
+    bakeChunk(map_, cx, cz, scratch_);
+    upload(mesh, scratch_.vertices.data(), scratch_.vertices.size(),
+           scratch_.indices.data(), scratch_.indices.size());
+
+    mesh.builtRevision = map_.chunkRevision(cx, cz);
+    mesh.origin        = chunkOrigin(map_, cx, cz);
+    mesh.boundsMin     = scratch_.boundsMin;
+    mesh.boundsMax     = scratch_.boundsMax;
+}
+
+void MapChunks::upload(ChunkMesh& mesh, const ChunkVertex* vertices, size_t vertexCount,
+                       const unsigned int* indices, size_t indexCount)
+{
+    if (mesh.VAO == 0)
+    {
+        glGenVertexArrays(1, &mesh.VAO);
+        glGenBuffers(1, &mesh.VBO);
+        glGenBuffers(1, &mesh.EBO);
+
+        glBindVertexArray(mesh.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+
+        // Packed position, tex coords, normal plus the material layer
+        chunkVertexFormat().apply();
+    }
+    else
+    {
+        glBindVertexArray(mesh.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    }
+
+    // Terrain is rebuilt rarely (on edits), so keep it in static storage
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(ChunkVertex), vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
+    mesh.indexCount = (int)indexCount;
+}
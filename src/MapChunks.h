@@ -0,0 +1,95 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_MAPCHUNKS_H
+#define TACTICGAME_MAPCHUNKS_H
+
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "VertexFormat.h"
+
+class MapFile;
+class TileMap;
+
+// CPU side of one chunk, as baked by MapChunks::bakeChunk (no GL needed,
+// so the offline map compiler can pre-bake it)
+struct ChunkGeometry
+{
+    std::vector<ChunkVertex> vertices; // relative to chunkOrigin()
+    std::vector<unsigned int> indices; // relative to this chunk's vertices
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+
+    void clear();
+};
+
+// Baked geometry for one kChunkSize x kChunkSize block of tiles
+struct ChunkMesh
+{
+    unsigned int VAO = 0;
+    unsigned int VBO = 0;
+    unsigned int EBO = 0;
+    int indexCount = 0;
+
+    // TileMap::chunkRevision() this mesh was built from
+    std::uint32_t builtRevision = 0;
+
+    // Vertex positions are fixed point from here (see ChunkVertex)
+    glm::vec3 origin{0.0f};
+
+    // World-space bounds of the baked geometry
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+};
+
+// Merges the board into static per-chunk meshes. Only faces that can be
+// seen are emitted: tops, plus the part of a side that sticks out above its
+// neighbour (or the map edge). Bottoms and faces between equal-height
+// neighbours are dropped.
+class MapChunks
+{
+public:
+    explicit MapChunks(const TileMap& map);
+    // Uploads the file's pre-baked chunks straight from the mapping instead of
+    // meshing; falls back to baking if the file has none for this layout.
+    // `map` must be the unedited board loaded from `baked`.
+    MapChunks(const TileMap& map, const MapFile& baked);
+    ~MapChunks();
+
+    MapChunks(const MapChunks&) = delete;
+    MapChunks& operator=(const MapChunks&) = delete;
+
+    // Rebuild chunks whose tiles changed since they were baked; returns how many
+    int update();
+
+    void draw() const;
+    void drawChunk(int index) const;
+
+    int chunkCount() const { return (int)chunks_.size(); }
+    const ChunkMesh& chunk(int index) const { return chunks_[index]; }
+
+    int triangleCount() const;
+
+    static void bakeChunk(const TileMap& map, int cx, int cz, ChunkGeometry& out);
+    // Where chunk (cx, cz)'s quantized positions count from: its tiles'
+    // lowest corner, at the bottom of the columns
+    static glm::vec3 chunkOrigin(const TileMap& map, int cx, int cz);
+
+private:
+    const TileMap& map_;
+    std::vector<ChunkMesh> chunks_;
+
+    // Scratch geometry reused across rebuilds
+    ChunkGeometry scratch_;
+
+    void buildChunk(int cx, int cz, ChunkMesh& mesh);
+    static void upload(ChunkMesh& mesh, const ChunkVertex* vertices, size_t vertexCount,
+                       const unsigned int* indices, size_t indexCount);
+};
+
+
+#endif //TACTICGAME_MAPCHUNKS_H
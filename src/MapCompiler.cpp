@@ -0,0 +1,170 @@
+//
+// Created by User on 14/10/2026.
+//
+// MapCompiler: converts a JSON map (the authoring format) into the binary
+// .tgmap the game memory-maps at load, baking the chunk meshes on the way.
+//
+//   MapCompiler input.json output.tgmap [--no-meshes]
+//
+// {
+//   "width": 10, "depth": 10,
+//   "fill":    { "height": 1.0, "type": 0 },                    // optional
+//   "regions": [ { "x": 0, "z": 5, "w": 10, "d": 1,             // applied in order
+//                  "height": 1.0, "type": 1 } ],
+//   "spawns":  [ { "tile": [3, 2], "team": 0,                   // first team 0 spawn is the player
+//                  "target": [2, 5], "moveSpeed": 0.6,          // all optional but "tile"
+//                  "hp": 10, "scale": 1.0, "vision": 5 } ]
+// }
+//
+
+#include <rapidjson/document.h>
+#include <spdlog/spdlog.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MapFile.h"
+#include "TileMap.h"
+#include "VertexFormat.h"
+
+namespace {
+
+float floatOr(const rapidjson::Value& object, const char* name, float fallback)
+{
+    if (!object.IsObject() || !object.HasMember(name) || !object[name].IsNumber()) {
+        return fallback;
+    }
+    return object[name].GetFloat();
+}
+
+int intOr(const rapidjson::Value& object, const char* name, int fallback)
+{
+    if (!object.IsObject() || !object.HasMember(name) || !object[name].IsInt()) {
+        return fallback;
+    }
+    return object[name].GetInt();
+}
+
+// [i, j] pair; false if missing or malformed
+bool readTile(const rapidjson::Value& object, const char* name, int& i, int& j)
+{
+    if (!object.HasMember(name)) {
+        return false;
+    }
+    const rapidjson::Value& tile = object[name];
+    if (!tile.IsArray() || tile.Size() != 2 || !tile[0].IsInt() || !tile[1].IsInt()) {
+        return false;
+    }
+    i = tile[0].GetInt();
+    j = tile[1].GetInt();
+    return true;
+}
+
+// Baked chunk vertices store heights in fixed point (ChunkVertex)
+bool heightFits(float height)
+{
+    return height >= 0.0f && height <= kChunkMaxHeight;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        spdlog::error("usage: MapCompiler input.json output.tgmap [--no-meshes]");
+        return 1;
+    }
+    const std::string inputPath = argv[1];
+    const std::string outputPath = argv[2];
+    const bool bakeMeshes = !(argc > 3 && std::strcmp(argv[3], "--no-meshes") == 0);
+
+    std::ifstream input(inputPath);
+    if (!input) {
+        spdlog::error("MapCompiler: cannot open {}", inputPath);
+        return 1;
+    }
+    std::stringstream text;
+    text << input.rdbuf();
+
+    rapidjson::Document doc;
+    doc.Parse(text.str().c_str());
+    if (doc.HasParseError() || !doc.IsObject()) {
+        spdlog::error("MapCompiler: {} is not valid JSON (offset {})", inputPath, (size_t)doc.GetErrorOffset());
+        return 1;
+    }
+
+    const int width = intOr(doc, "width", 0);
+    const int depth = intOr(doc, "depth", 0);
+    if (width <= 0 || depth <= 0 || width > (int)kMaxMapDimension || depth > (int)kMaxMapDimension) {
+        spdlog::error("MapCompiler: {} needs a width and depth in 1..{}", inputPath, kMaxMapDimension);
+        return 1;
+    }
+
+    TileMap map(width, depth);
+    if (doc.HasMember("fill")) {
+        const float height = floatOr(doc["fill"], "height", 1.0f);
+        const int type = intOr(doc["fill"], "type", 0);
+        if (!heightFits(height)) {
+            spdlog::error("MapCompiler: fill height {} is outside 0..{}", height, kChunkMaxHeight);
+            return 1;
+        }
+        for (int i = 0; i < width; ++i) {
+            for (int j = 0; j < depth; ++j) {
+                map.setTile(i, j, height, type);
+            }
+        }
+    }
+
+    if (doc.HasMember("regions") && doc["regions"].IsArray()) {
+        const rapidjson::Value& regions = doc["regions"];
+        for (rapidjson::SizeType r = 0; r < regions.Size(); ++r) {
+            const rapidjson::Value& region = regions[r];
+            const int x = intOr(region, "x", 0);
+            const int z = intOr(region, "z", 0);
+            const int w = intOr(region, "w", 1);
+            const int d = intOr(region, "d", 1);
+            const float height = floatOr(region, "height", 1.0f);
+            const int type = intOr(region, "type", 0);
+            if (!heightFits(height)) {
+                spdlog::error("MapCompiler: region {} height {} is outside 0..{}", r, height, kChunkMaxHeight);
+                return 1;
+            }
+            for (int i = x; i < x + w; ++i) {
+                for (int j = z; j < z + d; ++j) {
+                    map.setTile(i, j, height, type);
+                }
+            }
+        }
+    }
+
+    std::vector<MapSpawn> spawns;
+    if (doc.HasMember("spawns") && doc["spawns"].IsArray()) {
+        const rapidjson::Value& list = doc["spawns"];
+        for (rapidjson::SizeType s = 0; s < list.Size(); ++s) {
+            const rapidjson::Value& entry = list[s];
+            MapSpawn spawn{};
+            if (!entry.IsObject() || !readTile(entry, "tile", spawn.i, spawn.j) || !map.inBounds(spawn.i, spawn.j)) {
+                spdlog::error("MapCompiler: spawn {} needs an in-bounds \"tile\": [i, j]", s);
+                return 1;
+            }
+            if (!readTile(entry, "target", spawn.targetI, spawn.targetJ)) {
+                spawn.targetI = -1;
+                spawn.targetJ = -1;
+            }
+            spawn.moveSpeed = floatOr(entry, "moveSpeed", 1.2f);
+            spawn.scale     = floatOr(entry, "scale", 1.0f);
+            spawn.hp        = (std::int16_t)intOr(entry, "hp", 10);
+            spawn.team      = (std::uint8_t)intOr(entry, "team", 0);
+            spawn.vision    = (std::uint8_t)intOr(entry, "vision", 5);
+            spawns.push_back(spawn);
+        }
+    }
+
+    if (!writeMapFile(outputPath, map, spawns, bakeMeshes)) {
+        return 1;
+    }
+    spdlog::info("MapCompiler: {} -> {} ({}x{}, {} spawns{})", inputPath, outputPath, width, depth,
+                 spawns.size(), bakeMeshes ? ", meshes baked" : "");
+    return 0;
+}
@@ -0,0 +1,263 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "MapFile.h"
+#include "MapChunks.h"
+#include "TileMap.h"
+#include <spdlog/spdlog.h>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::uint64_t kSectionAlign = 16;
+
+std::uint64_t alignUp(std::uint64_t value)
+{
+    return (value + kSectionAlign - 1) & ~(kSectionAlign - 1);
+}
+
+// Section of `count` elements of `elementBytes` at `offset` lies inside the
+// file and is aligned. Divides instead of multiplying, so header values
+// large enough to wrap the product can't pass.
+bool sectionFits(std::uint64_t offset, std::uint64_t count, std::uint64_t elementBytes, size_t fileSize)
+{
+    if (offset % kSectionAlign != 0 || offset > fileSize) {
+        return false;
+    }
+    return count == 0 || (elementBytes > 0 && count <= (fileSize - offset) / elementBytes);
+}
+
+} // namespace
+
+std::unique_ptr<MapFile> MapFile::open(const std::string& path)
+{
+    std::unique_ptr<MapFile> file(new MapFile());
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        spdlog::error("MapFile: cannot open {}", path);
+        return nullptr;
+    }
+    file->file_ = handle;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart < (LONGLONG)sizeof(MapFileHeader)) {
+        spdlog::error("MapFile: {} is too small", path);
+        return nullptr;
+    }
+    file->mapping_ = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!file->mapping_) {
+        spdlog::error("MapFile: cannot map {}", path);
+        return nullptr;
+    }
+    file->data_ = static_cast<const std::uint8_t*>(MapViewOfFile(file->mapping_, FILE_MAP_READ, 0, 0, 0));
+    file->size_ = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        spdlog::error("MapFile: cannot open {}", path);
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(MapFileHeader)) {
+        spdlog::error("MapFile: {} is too small", path);
+        ::close(fd);
+        return nullptr;
+    }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive on its own
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        spdlog::error("MapFile: cannot map {}", path);
+        return nullptr;
+    }
+    file->data_ = static_cast<const std::uint8_t*>(data);
+    file->size_ = (size_t)st.st_size;
+#endif
+
+    if (!file->data_ || !file->validate(path)) {
+        return nullptr;
+    }
+    return file;
+}
+
+MapFile::~MapFile()
+{
+#ifdef _WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+    if (file_) {
+        CloseHandle(file_);
+    }
+#else
+    if (data_) {
+        munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+#endif
+}
+
+bool MapFile::validate(const std::string& path) const
+{
+    const MapFileHeader& h = header();
+    if (std::memcmp(h.magic, kMapFileMagic, sizeof(kMapFileMagic)) != 0) {
+        spdlog::error("MapFile: {} is not a map file", path);
+        return false;
+    }
+    if (h.version != kMapFileVersion) {
+        spdlog::error("MapFile: {} is version {}, expected {} (recompile it)", path, h.version, kMapFileVersion);
+        return false;
+    }
+
+    if (h.width == 0 || h.depth == 0 || h.width > kMaxMapDimension || h.depth > kMaxMapDimension) {
+        spdlog::error("MapFile: {} is {}x{}, outside 1..{}", path, h.width, h.depth, kMaxMapDimension);
+        return false;
+    }
+
+    // Bounded dimensions, so this can't wrap
+    const std::uint64_t tiles = (std::uint64_t)h.width * h.depth;
+    bool ok = sectionFits(h.heightsOffset, tiles, sizeof(float), size_)
+              && sectionFits(h.typesOffset, tiles, 1, size_)
+              && sectionFits(h.spawnsOffset, h.spawnCount, sizeof(MapSpawn), size_)
+              && sectionFits(h.chunksOffset, h.chunkCount, sizeof(MapChunkRecord), size_)
+              && sectionFits(h.verticesOffset, h.vertexCount, h.vertexBytes, size_)
+              && sectionFits(h.indicesOffset, h.indexCount, sizeof(std::uint32_t), size_);
+
+    // Chunk ranges must stay inside the shared vertex/index arrays, and
+    // every index inside its own chunk's vertices
+    const std::uint32_t* indices = section<std::uint32_t>(h.indicesOffset);
+    for (std::uint32_t c = 0; ok && c < h.chunkCount; ++c) {
+        const MapChunkRecord& record = chunk((int)c);
+        ok = (std::uint64_t)record.firstVertex + record.vertexCount <= h.vertexCount
+             && (std::uint64_t)record.firstIndex + record.indexCount <= h.indexCount;
+        for (std::uint32_t k = 0; ok && k < record.indexCount; ++k) {
+            ok = indices[record.firstIndex + k] < record.vertexCount;
+        }
+    }
+    if (!ok) {
+        spdlog::error("MapFile: {} is truncated or corrupt", path);
+    }
+    return ok;
+}
+
+bool MapFile::hasBakedChunks() const
+{
+    const MapFileHeader& h = header();
+    const std::uint32_t chunksX = (h.width + kChunkSize - 1) / kChunkSize;
+    const std::uint32_t chunksZ = (h.depth + kChunkSize - 1) / kChunkSize;
+    return h.chunkCount == chunksX * chunksZ
+           && h.chunkSize == (std::uint32_t)kChunkSize
+           && h.vertexBytes == (std::uint32_t)sizeof(ChunkVertex);
+}
+
+const ChunkVertex* MapFile::chunkVertices(int index) const
+{
+    return section<ChunkVertex>(header().verticesOffset) + chunk(index).firstVertex;
+}
+
+const unsigned int* MapFile::chunkIndices(int index) const
+{
+    static_assert(sizeof(unsigned int) == sizeof(std::uint32_t), "indices are stored as uint32");
+    return section<unsigned int>(header().indicesOffset) + chunk(index).firstIndex;
+}
+
+TileMap MapFile::buildTileMap() const
+{
+    return TileMap(width(), depth(), heights(), types());
+}
+
+bool writeMapFile(const std::string& path, const TileMap& map,
+                  const std::vector<MapSpawn>& spawns, bool bakeChunks)
+{
+    // Bake every chunk into one shared vertex/index array
+    std::vector<MapChunkRecord> records;
+    std::vector<ChunkVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    if (bakeChunks) {
+        ChunkGeometry geometry;
+        records.reserve((size_t)map.chunkCount());
+        for (int cz = 0; cz < map.chunksZ(); ++cz) {
+            for (int cx = 0; cx < map.chunksX(); ++cx) {
+                MapChunks::bakeChunk(map, cx, cz, geometry);
+                MapChunkRecord record{};
+                record.firstVertex = (std::uint32_t)vertices.size();
+                record.vertexCount = (std::uint32_t)geometry.vertices.size();
+                record.firstIndex  = (std::uint32_t)indices.size();
+                record.indexCount  = (std::uint32_t)geometry.indices.size();
+                for (int k = 0; k < 3; ++k) {
+                    record.boundsMin[k] = geometry.boundsMin[k];
+                    record.boundsMax[k] = geometry.boundsMax[k];
+                }
+                records.push_back(record);
+                vertices.insert(vertices.end(), geometry.vertices.begin(), geometry.vertices.end());
+                indices.insert(indices.end(), geometry.indices.begin(), geometry.indices.end());
+            }
+        }
+    }
+
+    const size_t tiles = (size_t)map.width() * map.depth();
+    MapFileHeader h{};
+    std::memcpy(h.magic, kMapFileMagic, sizeof(kMapFileMagic));
+    h.version        = kMapFileVersion;
+    h.width          = (std::uint32_t)map.width();
+    h.depth          = (std::uint32_t)map.depth();
+    h.chunkSize      = (std::uint32_t)kChunkSize;
+    h.vertexBytes    = (std::uint32_t)sizeof(ChunkVertex);
+    h.spawnCount     = (std::uint32_t)spawns.size();
+    h.chunkCount     = (std::uint32_t)records.size();
+    h.vertexCount    = vertices.size();
+    h.indexCount     = indices.size();
+    h.heightsOffset  = alignUp(sizeof(MapFileHeader));
+    h.typesOffset    = alignUp(h.heightsOffset + tiles * sizeof(float));
+    h.spawnsOffset   = alignUp(h.typesOffset + tiles);
+    h.chunksOffset   = alignUp(h.spawnsOffset + spawns.size() * sizeof(MapSpawn));
+    h.verticesOffset = alignUp(h.chunksOffset + records.size() * sizeof(MapChunkRecord));
+    h.indicesOffset  = alignUp(h.verticesOffset + vertices.size() * sizeof(ChunkVertex));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        spdlog::error("MapFile: cannot write {}", path);
+        return false;
+    }
+    std::uint64_t written = 0;
+    auto put = [&](std::uint64_t offset, const void* bytes, size_t count) {
+        static const char zeros[kSectionAlign] = {};
+        out.write(zeros, (std::streamsize)(offset - written));
+        out.write(static_cast<const char*>(bytes), (std::streamsize)count);
+        written = offset + count;
+    };
+    put(0, &h, sizeof(h));
+    put(h.heightsOffset, map.heights().data(), tiles * sizeof(float));
+    put(h.typesOffset, map.types().data(), tiles);
+    put(h.spawnsOffset, spawns.data(), spawns.size() * sizeof(MapSpawn));
+    put(h.chunksOffset, records.data(), records.size() * sizeof(MapChunkRecord));
+    put(h.verticesOffset, vertices.data(), vertices.size() * sizeof(ChunkVertex));
+    put(h.indicesOffset, indices.data(), indices.size() * sizeof(std::uint32_t));
+
+    if (!out) {
+        spdlog::error("MapFile: failed writing {}", path);
+        return false;
+    }
+    return true;
+}
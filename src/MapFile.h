@@ -0,0 +1,141 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_MAPFILE_H
+#define TACTICGAME_MAPFILE_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TileMap;
+struct ChunkVertex;
+
+// Binary board format (.tgmap), little endian. Every section starts on a
+// 16-byte boundary and is stored exactly as the engine consumes it, so a
+// loaded file is used in place: the tile arrays are copied into a TileMap
+// with two memcpys, and baked chunk meshes go from the mapping straight
+// into glBufferData.
+//
+//   MapFileHeader
+//   heights   float[width * depth]        TileMap layout (i * depth + j)
+//   types     uint8[width * depth]
+//   spawns    MapSpawn[spawnCount]
+//   chunks    MapChunkRecord[chunkCount]  row-major by chunk (cz * chunksX + cx)
+//   vertices  ChunkVertex[]               packed, relative to each chunk's origin
+//   indices   uint32[]                    relative to each chunk's first vertex
+//
+// Bump kMapFileVersion whenever a struct below or the vertex layout changes;
+// older files are rejected rather than misread. Author maps in JSON and
+// convert them with the MapCompiler tool.
+constexpr char kMapFileMagic[4] = {'T', 'G', 'M', 'P'};
+constexpr std::uint32_t kMapFileVersion = 3;
+// Largest width or depth open() accepts (and MapCompiler writes)
+constexpr std::uint32_t kMaxMapDimension = 8192;
+
+struct MapFileHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t depth;
+    std::uint32_t chunkSize;    // kChunkSize the meshes were baked with
+    std::uint32_t vertexBytes;  // sizeof(ChunkVertex) the meshes were baked with
+    std::uint32_t spawnCount;
+    std::uint32_t chunkCount;   // 0 = no baked meshes
+    std::uint64_t heightsOffset;
+    std::uint64_t typesOffset;
+    std::uint64_t spawnsOffset;
+    std::uint64_t chunksOffset;
+    std::uint64_t verticesOffset;
+    std::uint64_t indicesOffset;
+    std::uint64_t vertexCount;
+    std::uint64_t indexCount;
+};
+static_assert(sizeof(MapFileHeader) == 96, "MapFileHeader layout is part of the file format");
+
+// A unit placed on the board at load
+struct MapSpawn
+{
+    std::int32_t i;
+    std::int32_t j;
+    std::int32_t targetI; // -1 = no standing order
+    std::int32_t targetJ;
+    float moveSpeed;
+    float scale;
+    std::int16_t hp;
+    std::uint8_t team;
+    std::uint8_t vision;
+};
+static_assert(sizeof(MapSpawn) == 28, "MapSpawn layout is part of the file format");
+
+struct MapChunkRecord
+{
+    std::uint32_t firstVertex;
+    std::uint32_t vertexCount;
+    std::uint32_t firstIndex;
+    std::uint32_t indexCount;
+    float boundsMin[3];
+    float boundsMax[3];
+};
+static_assert(sizeof(MapChunkRecord) == 40, "MapChunkRecord layout is part of the file format");
+
+// Read-only memory mapping of a .tgmap file. Only the header and section
+// bounds are checked on open; nothing is parsed.
+class MapFile
+{
+public:
+    // nullptr (and an error logged) if the file is missing or malformed
+    static std::unique_ptr<MapFile> open(const std::string& path);
+    ~MapFile();
+
+    MapFile(const MapFile&) = delete;
+    MapFile& operator=(const MapFile&) = delete;
+
+    int width() const { return (int)header().width; }
+    int depth() const { return (int)header().depth; }
+
+    const float* heights() const { return section<float>(header().heightsOffset); }
+    const std::uint8_t* types() const { return section<std::uint8_t>(header().typesOffset); }
+
+    int spawnCount() const { return (int)header().spawnCount; }
+    const MapSpawn& spawn(int index) const { return section<MapSpawn>(header().spawnsOffset)[index]; }
+
+    // Baked meshes are only usable if they were baked for this engine's layout
+    bool hasBakedChunks() const;
+    int chunkCount() const { return (int)header().chunkCount; }
+    const MapChunkRecord& chunk(int index) const { return section<MapChunkRecord>(header().chunksOffset)[index]; }
+    const ChunkVertex* chunkVertices(int index) const;
+    const unsigned int* chunkIndices(int index) const;
+
+    // Board with the file's tiles (all chunk revisions fresh)
+    TileMap buildTileMap() const;
+
+private:
+    MapFile() = default;
+
+    const std::uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+
+    const MapFileHeader& header() const { return *reinterpret_cast<const MapFileHeader*>(data_); }
+    template <typename T>
+    const T* section(std::uint64_t offset) const { return reinterpret_cast<const T*>(data_ + offset); }
+
+    bool validate(const std::string& path) const;
+};
+
+// Writes `map` and `spawns` as a .tgmap, baking chunk meshes if asked.
+// Returns false (and logs) on I/O failure.
+bool writeMapFile(const std::string& path, const TileMap& map,
+                  const std::vector<MapSpawn>& spawns, bool bakeChunks);
+
+
+#endif //TACTICGAME_MAPFILE_H
@@ -0,0 +1,134 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "MeshRegistry.h"
+#include <glad/glad.h>
+#include <cmath>
+
+MeshRegistry::MeshRegistry()
+        : dirty_(false),
+          VAO_(0), VBO_(0), EBO_(0)
+{
+    glGenVertexArrays(1, &VAO_);
+    glGenBuffers(1, &VBO_);
+    glGenBuffers(1, &EBO_);
+
+    glBindVertexArray(VAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
+
+    meshVertexFormat().apply();
+
+    glBindVertexArray(0);
+}
+
+MeshRegistry::~MeshRegistry()
+{
+    glDeleteVertexArrays(1, &VAO_);
+    glDeleteBuffers(1, &VBO_);
+    glDeleteBuffers(1, &EBO_);
+}
+
+MeshInfo& MeshRegistry::beginMesh(int vertexCount, int indexCount)
+{
+    MeshInfo mesh;
+    mesh.baseVertex  = (int)vertices_.size();
+    mesh.vertexCount = vertexCount;
+    mesh.indexCount  = indexCount;
+    mesh.indexType   = vertexCount <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    // Keep every mesh's indices 4-byte aligned whatever their width
+    indexBytes_.resize((indexBytes_.size() + 3) & ~(size_t)3);
+    mesh.indexOffset = indexBytes_.size();
+
+    const size_t indexSize = mesh.indexType == GL_UNSIGNED_SHORT ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+    vertices_.resize(vertices_.size() + (size_t)vertexCount);
+    indexBytes_.resize(indexBytes_.size() + (size_t)indexCount * indexSize);
+
+    meshes_.push_back(mesh);
+    dirty_ = true;
+    return meshes_.back();
+}
+
+MeshHandle MeshRegistry::sphere(float radius, int sectors, int stacks)
+{
+    const Key key(Kind::Sphere, radius, sectors, stacks);
+    auto it = lookup_.find(key);
+    if (it != lookup_.end()) {
+        return {it->second};
+    }
+
+    // (stacks + 1) rings of (sectors + 1) vertices; the poles' rings of
+    // quads collapse to single triangles
+    const int vertexCount = (stacks + 1) * (sectors + 1);
+    const int indexCount  = 6 * sectors * (stacks - 1);
+    const MeshInfo& mesh = beginMesh(vertexCount, indexCount);
+
+    MeshVertex* v = vertices_.data() + mesh.baseVertex;
+    const float lengthInv = 1.0f / radius;
+    for (int i = 0; i <= stacks; ++i) {
+        float stackAngle = (float)M_PI / 2.0f - (float)i * (float)M_PI / (float)stacks;
+        float xy = radius * cosf(stackAngle);
+        float y  = radius * sinf(stackAngle);
+
+        for (int j = 0; j <= sectors; ++j) {
+            float sectorAngle = (float)j * 2.0f * (float)M_PI / (float)sectors;
+            float x = xy * cosf(sectorAngle);
+            float z = xy * sinf(sectorAngle);
+
+            *v++ = packMeshVertex(glm::vec3(x, y, z),
+                                  glm::vec2((float)j / (float)sectors, (float)i / (float)stacks),
+                                  glm::vec3(x, y, z) * lengthInv);
+        }
+    }
+
+    auto emit = [&](auto* out) {
+        for (int i = 0; i < stacks; ++i) {
+            int k1 = i * (sectors + 1);
+            int k2 = k1 + sectors + 1;
+            for (int j = 0; j < sectors; ++j, ++k1, ++k2) {
+                if (i != 0) {
+                    *out++ = k1;
+                    *out++ = k2;
+                    *out++ = k1 + 1;
+                }
+                if (i != stacks - 1) {
+                    *out++ = k1 + 1;
+                    *out++ = k2;
+                    *out++ = k2 + 1;
+                }
+            }
+        }
+    };
+    std::uint8_t* indices = indexBytes_.data() + mesh.indexOffset;
+    if (mesh.indexType == GL_UNSIGNED_SHORT) {
+        emit(reinterpret_cast<std::uint16_t*>(indices));
+    } else {
+        emit(reinterpret_cast<std::uint32_t*>(indices));
+    }
+
+    const int index = meshCount() - 1;
+    lookup_.emplace(key, index);
+    return {index};
+}
+
+void MeshRegistry::bind()
+{
+    glBindVertexArray(VAO_);
+    if (!dirty_) {
+        return;
+    }
+    // Same buffer names, so the VAO's attribute pointers stay valid
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+    glBufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(MeshVertex), vertices_.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes_.size(), indexBytes_.data(), GL_STATIC_DRAW);
+    dirty_ = false;
+}
+
+void MeshRegistry::drawInstanced(MeshHandle mesh, int instances) const
+{
+    const MeshInfo& m = meshes_[mesh.index];
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, m.indexCount, m.indexType, (void*)m.indexOffset,
+                                      instances, m.baseVertex);
+}
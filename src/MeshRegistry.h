@@ -0,0 +1,81 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_MESHREGISTRY_H
+#define TACTICGAME_MESHREGISTRY_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "VertexFormat.h"
+
+// Stable handle to a registered mesh
+struct MeshHandle
+{
+    int index = -1;
+    bool valid() const { return index >= 0; }
+};
+
+// Where a mesh lives in the shared buffers
+struct MeshInfo
+{
+    int baseVertex = 0;
+    int vertexCount = 0;
+    std::size_t indexOffset = 0; // bytes into the shared index buffer
+    int indexCount = 0;
+    unsigned int indexType = 0;  // GL_UNSIGNED_SHORT when the mesh fits, else GL_UNSIGNED_INT
+};
+
+// Procedural meshes (packed MeshVertex: position, tex coords, normal) in
+// one shared VBO/EBO/VAO. Each unique parameter set is generated once, into
+// presized storage, and every request for it returns the same handle.
+// Indices are relative to the mesh's base vertex, so they stay 16-bit for
+// anything under 64K vertices however many meshes precede it.
+//
+// New meshes are uploaded on the next bind(); register everything up front
+// to keep that to once. Needs a current GL context.
+class MeshRegistry
+{
+public:
+    MeshRegistry();
+    ~MeshRegistry();
+
+    MeshRegistry(const MeshRegistry&) = delete;
+    MeshRegistry& operator=(const MeshRegistry&) = delete;
+
+    // UV sphere centred on the origin
+    MeshHandle sphere(float radius, int sectors, int stacks);
+
+    const MeshInfo& info(MeshHandle mesh) const { return meshes_[mesh.index]; }
+    int meshCount() const { return (int)meshes_.size(); }
+
+    // Uploads pending meshes and binds the shared VAO. Instance attributes
+    // set while it is bound persist across draws of every mesh in it.
+    void bind();
+    // Expects bind()
+    void drawInstanced(MeshHandle mesh, int instances) const;
+
+private:
+    enum class Kind { Sphere };
+    using Key = std::tuple<Kind, float, int, int>;
+
+    std::map<Key, int> lookup_;
+    std::vector<MeshInfo> meshes_;
+
+    // CPU copy of the shared buffers; small, kept for re-uploads
+    std::vector<MeshVertex> vertices_;
+    std::vector<std::uint8_t> indexBytes_;
+    bool dirty_;
+
+    unsigned int VAO_, VBO_, EBO_;
+
+    MeshInfo& beginMesh(int vertexCount, int indexCount);
+};
+
+
+#endif //TACTICGAME_MESHREGISTRY_H
@@ -0,0 +1,603 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Pathfinder.h"
+#include "TileMap.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static const float kInfinity = std::numeric_limits<float>::infinity();
+
+// 4-connected moves; FlowField::next stores an index into this
+static const glm::ivec2 kDirs[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+static float manhattan(glm::ivec2 a, glm::ivec2 b)
+{
+    return (float)(std::abs(a.x - b.x) + std::abs(a.y - b.y));
+}
+
+// --------------------------------------------------------------------------------
+// NodeHeap
+// --------------------------------------------------------------------------------
+void NodeHeap::reset(size_t nodeCount)
+{
+    // Only the nodes left queued by the last search need clearing
+    for (int node : heap_) {
+        slot_[node] = -1;
+    }
+    heap_.clear();
+    if (slot_.size() != nodeCount) {
+        slot_.assign(nodeCount, -1);
+        key_.assign(nodeCount, 0.0f);
+        heap_.reserve(nodeCount);
+    }
+}
+
+void NodeHeap::push(int node, float key)
+{
+    key_[node] = key;
+    if (slot_[node] >= 0) {
+        siftUp(slot_[node]);
+        return;
+    }
+    heap_.push_back(node);
+    slot_[node] = (int)heap_.size() - 1;
+    siftUp(slot_[node]);
+}
+
+int NodeHeap::pop()
+{
+    const int top = heap_.front();
+    slot_[top] = -1;
+    const int last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        place(0, last);
+        siftDown(0);
+    }
+    return top;
+}
+
+void NodeHeap::place(int pos, int node)
+{
+    heap_[pos] = node;
+    slot_[node] = pos;
+}
+
+void NodeHeap::siftUp(int pos)
+{
+    const int node = heap_[pos];
+    const float key = key_[node];
+    while (pos > 0) {
+        const int parent = (pos - 1) / 2;
+        if (key_[heap_[parent]] <= key) {
+            break;
+        }
+        place(pos, heap_[parent]);
+        pos = parent;
+    }
+    place(pos, node);
+}
+
+void NodeHeap::siftDown(int pos)
+{
+    const int count = (int)heap_.size();
+    const int node = heap_[pos];
+    const float key = key_[node];
+    for (;;) {
+        int child = pos * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && key_[heap_[child + 1]] < key_[heap_[child]]) {
+            ++child;
+        }
+        if (key <= key_[heap_[child]]) {
+            break;
+        }
+        place(pos, heap_[child]);
+        pos = child;
+    }
+    place(pos, node);
+}
+
+// --------------------------------------------------------------------------------
+// Pathfinder
+// --------------------------------------------------------------------------------
+Pathfinder::Pathfinder(const TileMap& map)
+        : map_(map),
+          width_(map.width()),
+          depth_(map.depth()),
+          search_(0),
+          lastExpanded_(0),
+          builtMapRevision_(0),
+          flowUse_(0)
+{
+    const size_t tiles = (size_t)width_ * depth_;
+    g_.assign(tiles, 0.0f);
+    parent_.assign(tiles, -1);
+    stamp_.assign(tiles, 0);
+    heap_.reset(tiles);
+    clusters_.resize(map_.chunkCount());
+}
+
+bool Pathfinder::stepCost(glm::ivec2 from, glm::ivec2 to, float& cost) const
+{
+    if (!map_.hasTile(to.x, to.y)) {
+        return false;
+    }
+    const float climb = std::fabs(map_.height(to.x, to.y) - map_.height(from.x, from.y));
+    if (climb > kMaxClimb) {
+        return false;
+    }
+    cost = 1.0f + climb;
+    return true;
+}
+
+bool Pathfinder::searchGrid(glm::ivec2 start, glm::ivec2 goal, glm::ivec2 lo, glm::ivec2 hi,
+                            float budget, std::vector<int>* settled)
+{
+    if (++search_ == 0) {
+        // Stamp wrapped; forget every old search
+        std::fill(stamp_.begin(), stamp_.end(), 0u);
+        search_ = 1;
+    }
+    heap_.reset(stamp_.size());
+    lastExpanded_ = 0;
+
+    const bool dijkstra = goal.x < 0;
+    const int startNode = index(start);
+    const int goalNode = dijkstra ? -1 : index(goal);
+
+    g_[startNode] = 0.0f;
+    parent_[startNode] = -1;
+    stamp_[startNode] = search_;
+    heap_.push(startNode, dijkstra ? 0.0f : manhattan(start, goal));
+
+    while (!heap_.empty()) {
+        const int node = heap_.pop();
+        ++lastExpanded_;
+        if (node == goalNode) {
+            return true;
+        }
+        if (settled) {
+            settled->push_back(node);
+        }
+
+        const glm::ivec2 tile = tileOf(node);
+        for (const glm::ivec2& dir : kDirs) {
+            const glm::ivec2 next = tile + dir;
+            if (next.x < lo.x || next.y < lo.y || next.x >= hi.x || next.y >= hi.y) {
+                continue;
+            }
+            float cost;
+            if (!stepCost(tile, next, cost)) {
+                continue;
+            }
+            const float g = g_[node] + cost;
+            if (g > budget) {
+                continue;
+            }
+            const int nextNode = index(next);
+            if (stamp_[nextNode] == search_ && g >= g_[nextNode]) {
+                continue;
+            }
+            stamp_[nextNode] = search_;
+            g_[nextNode] = g;
+            parent_[nextNode] = node;
+            heap_.push(nextNode, dijkstra ? g : g + manhattan(next, goal));
+        }
+    }
+    return dijkstra;
+}
+
+void Pathfinder::tracePath(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path, bool append) const
+{
+    if (!append) {
+        path.clear();
+    }
+    const size_t begin = path.size();
+    for (int node = index(goal); node >= 0; node = parent_[node]) {
+        path.push_back(tileOf(node));
+        if (node == index(start)) {
+            break;
+        }
+    }
+    std::reverse(path.begin() + (std::ptrdiff_t)begin, path.end());
+    // Joining two legs: the first tile of this leg ends the previous one
+    if (append && begin > 0 && path.size() > begin && path[begin - 1] == path[begin]) {
+        path.erase(path.begin() + (std::ptrdiff_t)begin);
+    }
+}
+
+bool Pathfinder::findPath(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path)
+{
+    path.clear();
+    if (!map_.hasTile(start.x, start.y) || !map_.hasTile(goal.x, goal.y)) {
+        return false;
+    }
+    if (start == goal) {
+        path.push_back(start);
+        return true;
+    }
+
+    // Within a chunk or two the plain search is cheap and exact
+    const int chunkDx = std::abs(start.x / kChunkSize - goal.x / kChunkSize);
+    const int chunkDz = std::abs(start.y / kChunkSize - goal.y / kChunkSize);
+    if (std::max(chunkDx, chunkDz) <= 1) {
+        if (!searchGrid(start, goal, glm::ivec2(0), glm::ivec2(width_, depth_))) {
+            return false;
+        }
+        tracePath(start, goal, path, false);
+        return true;
+    }
+    return findPathHierarchical(start, goal, path);
+}
+
+void Pathfinder::reachable(glm::ivec2 start, float budget, std::pmr::vector<ReachableTile>& out)
+{
+    out.clear();
+    if (!map_.hasTile(start.x, start.y)) {
+        return;
+    }
+    settled_.clear();
+    searchGrid(start, glm::ivec2(-1), glm::ivec2(0), glm::ivec2(width_, depth_), budget, &settled_);
+    out.reserve(settled_.size());
+    for (int node : settled_) {
+        out.push_back(ReachableTile{tileOf(node), g_[node]});
+    }
+}
+
+// --------------------------------------------------------------------------------
+// Hierarchy: one cluster per map chunk, entrances where borders can be crossed
+// --------------------------------------------------------------------------------
+int Pathfinder::clusterOf(glm::ivec2 t) const
+{
+    return (t.y / kChunkSize) * map_.chunksX() + t.x / kChunkSize;
+}
+
+void Pathfinder::clusterBounds(int cluster, glm::ivec2& lo, glm::ivec2& hi) const
+{
+    const int cx = cluster % map_.chunksX();
+    const int cz = cluster / map_.chunksX();
+    lo = glm::ivec2(cx * kChunkSize, cz * kChunkSize);
+    hi = glm::ivec2(std::min(lo.x + kChunkSize, width_), std::min(lo.y + kChunkSize, depth_));
+}
+
+// Walks one border; every maximal run of crossable, mutually connected tile
+// pairs becomes a single entrance at its middle. Both clusters sharing a
+// border scan the same pairs in the same order, so they agree on entrances.
+void Pathfinder::scanBorder(glm::ivec2 first, glm::ivec2 along, glm::ivec2 across, int length,
+                            std::vector<Entrance>& out) const
+{
+    int runStart = -1;
+    for (int k = 0; k <= length; ++k) {
+        bool open = false;
+        if (k < length) {
+            const glm::ivec2 a = first + along * k;
+            float cost;
+            open = map_.hasTile(a.x, a.y) && stepCost(a, a + across, cost);
+            // A run only continues if both sides connect along the border
+            if (open && runStart >= 0) {
+                const glm::ivec2 prev = a - along;
+                open = stepCost(prev, a, cost) && stepCost(prev + across, a + across, cost);
+                if (!open) {
+                    const int mid = runStart + (k - 1 - runStart) / 2;
+                    out.push_back(Entrance{first + along * mid, first + along * mid + across});
+                    runStart = k; // this pair starts the next run
+                    continue;
+                }
+            }
+        }
+        if (open && runStart < 0) {
+            runStart = k;
+        } else if (!open && runStart >= 0) {
+            const int mid = runStart + (k - 1 - runStart) / 2;
+            out.push_back(Entrance{first + along * mid, first + along * mid + across});
+            runStart = -1;
+        }
+    }
+}
+
+void Pathfinder::findEntrances(int cluster, std::vector<Entrance>& out) const
+{
+    out.clear();
+    glm::ivec2 lo, hi;
+    clusterBounds(cluster, lo, hi);
+    const int cx = cluster % map_.chunksX();
+    const int cz = cluster / map_.chunksX();
+
+    if (cx > 0) {
+        scanBorder(lo, glm::ivec2(0, 1), glm::ivec2(-1, 0), hi.y - lo.y, out);
+    }
+    if (cx + 1 < map_.chunksX()) {
+        scanBorder(glm::ivec2(hi.x - 1, lo.y), glm::ivec2(0, 1), glm::ivec2(1, 0), hi.y - lo.y, out);
+    }
+    if (cz > 0) {
+        scanBorder(lo, glm::ivec2(1, 0), glm::ivec2(0, -1), hi.x - lo.x, out);
+    }
+    if (cz + 1 < map_.chunksZ()) {
+        scanBorder(glm::ivec2(lo.x, hi.y - 1), glm::ivec2(1, 0), glm::ivec2(0, 1), hi.x - lo.x, out);
+    }
+}
+
+void Pathfinder::refreshClusters()
+{
+    if (builtMapRevision_ == map_.revision()) {
+        return;
+    }
+
+    for (int c = 0; c < (int)clusters_.size(); ++c) {
+        Cluster& cluster = clusters_[c];
+        // An edit bumps the chunks of the tile and its neighbours, so an
+        // unchanged revision means unchanged entrances and costs
+        const std::uint32_t revision = map_.chunkRevision(c % map_.chunksX(), c / map_.chunksX());
+        if (cluster.builtRevision == revision) {
+            continue;
+        }
+        findEntrances(c, cluster.entrances);
+
+        // All-pairs in-cluster costs, one bounded Dijkstra per entrance
+        glm::ivec2 lo, hi;
+        clusterBounds(c, lo, hi);
+        const size_t n = cluster.entrances.size();
+        cluster.costs.assign(n * n, kInfinity);
+        for (size_t a = 0; a < n; ++a) {
+            searchGrid(cluster.entrances[a].tile, glm::ivec2(-1), lo, hi);
+            for (size_t b = 0; b < n; ++b) {
+                const int node = index(cluster.entrances[b].tile);
+                if (stamp_[node] == search_) {
+                    cluster.costs[a * n + b] = g_[node];
+                }
+            }
+        }
+        cluster.builtRevision = revision;
+    }
+
+    // Renumber the abstract graph; cheap next to the searches above
+    int nodeCount = 0;
+    for (Cluster& cluster : clusters_) {
+        cluster.firstNode = nodeCount;
+        nodeCount += (int)cluster.entrances.size();
+    }
+    nodeCluster_.resize(nodeCount);
+    nodePartner_.assign(nodeCount, -1);
+    for (int c = 0; c < (int)clusters_.size(); ++c) {
+        const Cluster& cluster = clusters_[c];
+        for (size_t k = 0; k < cluster.entrances.size(); ++k) {
+            const Entrance& e = cluster.entrances[k];
+            const int node = cluster.firstNode + (int)k;
+            nodeCluster_[node] = c;
+            const Cluster& other = clusters_[clusterOf(e.partner)];
+            for (size_t j = 0; j < other.entrances.size(); ++j) {
+                if (other.entrances[j].tile == e.partner && other.entrances[j].partner == e.tile) {
+                    nodePartner_[node] = other.firstNode + (int)j;
+                    break;
+                }
+            }
+        }
+    }
+    abstractG_.resize(nodeCount + 2);
+    abstractParent_.resize(nodeCount + 2);
+    builtMapRevision_ = map_.revision();
+}
+
+bool Pathfinder::findPathHierarchical(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path)
+{
+    refreshClusters();
+
+    const int startCluster = clusterOf(start);
+    const int goalCluster = clusterOf(goal);
+    const int nodeCount = (int)nodeCluster_.size();
+    const int startNode = nodeCount;
+    const int goalNode = nodeCount + 1;
+
+    // Connect start and goal to the entrances of their clusters
+    glm::ivec2 lo, hi;
+    const Cluster& sc = clusters_[startCluster];
+    clusterBounds(startCluster, lo, hi);
+    searchGrid(start, glm::ivec2(-1), lo, hi);
+    startEdges_.assign(sc.entrances.size(), kInfinity);
+    for (size_t k = 0; k < sc.entrances.size(); ++k) {
+        const int node = index(sc.entrances[k].tile);
+        if (stamp_[node] == search_) startEdges_[k] = g_[node];
+    }
+    const Cluster& gc = clusters_[goalCluster];
+    clusterBounds(goalCluster, lo, hi);
+    searchGrid(goal, glm::ivec2(-1), lo, hi); // costs are symmetric
+    goalEdges_.assign(gc.entrances.size(), kInfinity);
+    for (size_t k = 0; k < gc.entrances.size(); ++k) {
+        const int node = index(gc.entrances[k].tile);
+        if (stamp_[node] == search_) goalEdges_[k] = g_[node];
+    }
+
+    auto nodeTile = [&](int node) {
+        if (node == startNode) return start;
+        if (node == goalNode) return goal;
+        const Cluster& c = clusters_[nodeCluster_[node]];
+        return c.entrances[node - c.firstNode].tile;
+    };
+
+    // A* over entrances
+    abstractHeap_.reset((size_t)nodeCount + 2);
+    std::fill(abstractG_.begin(), abstractG_.end(), kInfinity);
+    std::fill(abstractParent_.begin(), abstractParent_.end(), -1);
+    abstractG_[startNode] = 0.0f;
+    abstractHeap_.push(startNode, manhattan(start, goal));
+
+    auto relax = [&](int from, int to, float cost) {
+        if (cost == kInfinity) return;
+        const float g = abstractG_[from] + cost;
+        if (g < abstractG_[to]) {
+            abstractG_[to] = g;
+            abstractParent_[to] = from;
+            abstractHeap_.push(to, g + manhattan(nodeTile(to), goal));
+        }
+    };
+
+    bool found = false;
+    while (!abstractHeap_.empty()) {
+        const int node = abstractHeap_.pop();
+        if (node == goalNode) {
+            found = true;
+            break;
+        }
+        if (node == startNode) {
+            for (size_t k = 0; k < sc.entrances.size(); ++k) {
+                relax(node, sc.firstNode + (int)k, startEdges_[k]);
+            }
+            continue;
+        }
+        const int c = nodeCluster_[node];
+        const Cluster& cluster = clusters_[c];
+        const size_t n = cluster.entrances.size();
+        const size_t local = (size_t)(node - cluster.firstNode);
+        for (size_t j = 0; j < n; ++j) {
+            if (j != local) {
+                relax(node, cluster.firstNode + (int)j, cluster.costs[local * n + j]);
+            }
+        }
+        float cost;
+        const int partner = nodePartner_[node];
+        if (partner >= 0 && stepCost(cluster.entrances[local].tile, cluster.entrances[local].partner, cost)) {
+            relax(node, partner, cost);
+        }
+        if (c == goalCluster) {
+            relax(node, goalNode, goalEdges_[local]);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Refine each abstract hop into tiles
+    waypoints_.clear();
+    for (int node = goalNode; node >= 0; node = abstractParent_[node]) {
+        waypoints_.push_back(nodeTile(node));
+    }
+    std::reverse(waypoints_.begin(), waypoints_.end());
+
+    path.clear();
+    path.push_back(start);
+    for (size_t w = 1; w < waypoints_.size(); ++w) {
+        const glm::ivec2 from = waypoints_[w - 1];
+        const glm::ivec2 to = waypoints_[w];
+        if (from == to) {
+            continue;
+        }
+        if (clusterOf(from) != clusterOf(to)) {
+            path.push_back(to); // border crossing, always a single step
+            continue;
+        }
+        clusterBounds(clusterOf(from), lo, hi);
+        if (!searchGrid(from, to, lo, hi)) {
+            path.clear();
+            return false;
+        }
+        tracePath(from, to, path, true);
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------------
+// Flow fields
+// --------------------------------------------------------------------------------
+const FlowField& Pathfinder::flowField(glm::ivec2 goal)
+{
+    ++flowUse_;
+    FlowField* slot = nullptr;
+    for (FlowField& field : flowFields_) {
+        if (field.goal == goal) {
+            slot = &field;
+            break;
+        }
+    }
+    if (slot) {
+        if (flowFieldStale(*slot)) {
+            buildFlowField(*slot);
+        }
+    } else {
+        if ((int)flowFields_.size() < kFlowFieldCacheSize) {
+            flowFields_.emplace_back();
+            slot = &flowFields_.back();
+        } else {
+            slot = &*std::min_element(flowFields_.begin(), flowFields_.end(),
+                                      [](const FlowField& a, const FlowField& b) { return a.lastUse < b.lastUse; });
+        }
+        slot->goal = goal;
+        buildFlowField(*slot);
+    }
+    slot->lastUse = flowUse_;
+    return *slot;
+}
+
+// A field only goes stale when an edited chunk holds tiles it reached. Edits
+// elsewhere can't matter: a tile next to a reached one bumps that
+// neighbour's chunk too, so an edit that opens a new route is still seen.
+bool Pathfinder::flowFieldStale(FlowField& field) const
+{
+    if (field.mapRevision == map_.revision()) {
+        return false;
+    }
+    bool stale = false;
+    for (int c = 0; c < map_.chunkCount() && !stale; ++c) {
+        const std::uint32_t revision = map_.chunkRevision(c % map_.chunksX(), c / map_.chunksX());
+        stale = revision != field.chunkRevisions[c] && field.chunkReached[c];
+    }
+    if (!stale) {
+        // Still valid; adopt the new revisions so the next check is the fast one
+        for (int c = 0; c < map_.chunkCount(); ++c) {
+            field.chunkRevisions[c] = map_.chunkRevision(c % map_.chunksX(), c / map_.chunksX());
+        }
+        field.mapRevision = map_.revision();
+    }
+    return stale;
+}
+
+void Pathfinder::buildFlowField(FlowField& field)
+{
+    const size_t tiles = (size_t)width_ * depth_;
+    field.cost.assign(tiles, kInfinity);
+    field.next.assign(tiles, -1);
+    field.chunkReached.assign(map_.chunkCount(), 0);
+    field.chunkRevisions.resize(map_.chunkCount());
+    for (int c = 0; c < map_.chunkCount(); ++c) {
+        field.chunkRevisions[c] = map_.chunkRevision(c % map_.chunksX(), c / map_.chunksX());
+    }
+    field.mapRevision = map_.revision();
+
+    if (!map_.hasTile(field.goal.x, field.goal.y)) {
+        return;
+    }
+
+    // Costs are symmetric, so Dijkstra out from the goal gives every
+    // tile's cost to it, and the search parent is the step toward it
+    settled_.clear();
+    searchGrid(field.goal, glm::ivec2(-1), glm::ivec2(0), glm::ivec2(width_, depth_), kInfinity, &settled_);
+    for (int node : settled_) {
+        field.cost[node] = g_[node];
+        const glm::ivec2 tile = tileOf(node);
+        field.chunkReached[clusterOf(tile)] = 1;
+        if (parent_[node] < 0) {
+            continue;
+        }
+        const glm::ivec2 step = tileOf(parent_[node]) - tile;
+        for (int d = 0; d < 4; ++d) {
+            if (kDirs[d] == step) {
+                field.next[node] = (std::int8_t)d;
+                break;
+            }
+        }
+    }
+}
+
+glm::ivec2 Pathfinder::nextStep(const FlowField& field, glm::ivec2 from) const
+{
+    if (!map_.inBounds(from.x, from.y)) {
+        return from;
+    }
+    const int dir = field.next[index(from)];
+    return dir < 0 ? from : from + kDirs[dir];
+}
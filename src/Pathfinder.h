@@ -0,0 +1,159 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_PATHFINDER_H
+#define TACTICGAME_PATHFINDER_H
+
+
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+#include <glm/glm.hpp>
+
+class TileMap;
+
+// Binary min-heap over node ids with decrease-key, stored in flat arrays
+// sized once per map. Reused by every search, so queries don't allocate.
+class NodeHeap
+{
+public:
+    void reset(size_t nodeCount);
+
+    bool empty() const { return heap_.empty(); }
+    bool contains(int node) const { return slot_[node] >= 0; }
+    // Inserts, or lowers the key of a node already queued
+    void push(int node, float key);
+    int pop();
+
+private:
+    std::vector<int> heap_;
+    std::vector<float> key_;  // per node
+    std::vector<int> slot_;   // per node: position in heap_, -1 when not queued
+
+    void siftUp(int pos);
+    void siftDown(int pos);
+    void place(int pos, int node);
+};
+
+// Integrated cost-to-goal and next step for every tile, for many units
+// sharing a destination. Built by Pathfinder::flowField().
+struct FlowField
+{
+    glm::ivec2 goal{-1, -1};
+    std::vector<float> cost;        // per tile, infinity = can't reach the goal
+    std::vector<std::int8_t> next;  // per tile, direction index (-1 = none / at goal)
+    // Map state it was built from, and which chunks it reached
+    std::uint32_t mapRevision = 0;
+    std::vector<std::uint32_t> chunkRevisions;
+    std::vector<std::uint8_t> chunkReached;
+    std::uint64_t lastUse = 0;
+};
+
+struct ReachableTile
+{
+    glm::ivec2 tile;
+    float cost;
+};
+
+// Tile-grid pathfinding: 4-connected moves onto existing tiles whose top is
+// at most kMaxClimb above or below the current one; a step costs 1 plus the
+// height difference. No GL in here; it runs wherever the simulation does.
+//
+// - findPath(): A* on the tile grid for short hops, hierarchical A* over
+//   chunk-sized clusters (HPA*) once start and goal are chunks apart.
+//   Cluster data is rebuilt lazily, per chunk, from TileMap chunk revisions.
+// - flowField(): cached per destination; a field is rebuilt on use when a
+//   chunk it was built from has changed.
+// - reachable(): movement range within a cost budget.
+class Pathfinder
+{
+public:
+    static constexpr float kMaxClimb = 0.5f;
+    static constexpr int kFlowFieldCacheSize = 8;
+
+    explicit Pathfinder(const TileMap& map);
+
+    // Fills path with the tiles from start to goal inclusive; false if unreachable
+    bool findPath(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path);
+
+    // Valid until the next flowField() call
+    const FlowField& flowField(glm::ivec2 goal);
+    // Next tile to step onto toward the field's goal (from itself if none)
+    glm::ivec2 nextStep(const FlowField& field, glm::ivec2 from) const;
+
+    void reachable(glm::ivec2 start, float budget, std::pmr::vector<ReachableTile>& out);
+
+    // Number of grid nodes expanded by the last findPath(), for profiling
+    int lastExpanded() const { return lastExpanded_; }
+
+private:
+    // An entrance tile on a cluster border and its partner across it
+    struct Entrance
+    {
+        glm::ivec2 tile;
+        glm::ivec2 partner;
+    };
+
+    struct Cluster
+    {
+        std::uint32_t builtRevision = 0;
+        std::vector<Entrance> entrances;
+        std::vector<float> costs; // entrances x entrances, in-cluster path costs
+        int firstNode = 0;        // id of entrances[0] in the abstract graph
+    };
+
+    const TileMap& map_;
+    int width_;
+    int depth_;
+
+    // Grid search state; stamp_ marks nodes touched by the current search
+    NodeHeap heap_;
+    std::vector<float> g_;
+    std::vector<int> parent_;
+    std::vector<std::uint32_t> stamp_;
+    std::uint32_t search_;
+    int lastExpanded_;
+    std::vector<int> settled_;
+
+    // Hierarchy
+    std::vector<Cluster> clusters_;
+    std::uint32_t builtMapRevision_;
+    std::vector<int> nodeCluster_;   // abstract node -> cluster
+    std::vector<int> nodePartner_;   // abstract node -> node across the border
+    NodeHeap abstractHeap_;
+    std::vector<float> abstractG_;
+    std::vector<int> abstractParent_;
+    std::vector<float> startEdges_;
+    std::vector<float> goalEdges_;
+    std::vector<glm::ivec2> waypoints_;
+
+    std::vector<FlowField> flowFields_;
+    std::uint64_t flowUse_;
+
+    int index(glm::ivec2 t) const { return t.x * depth_ + t.y; }
+    glm::ivec2 tileOf(int node) const { return glm::ivec2(node / depth_, node % depth_); }
+    bool stepCost(glm::ivec2 from, glm::ivec2 to, float& cost) const;
+
+    // Grid A* (or Dijkstra when goal is negative) inside [lo, hi), skipping
+    // nodes dearer than budget; settled collects expanded nodes
+    bool searchGrid(glm::ivec2 start, glm::ivec2 goal, glm::ivec2 lo, glm::ivec2 hi,
+                    float budget = std::numeric_limits<float>::infinity(),
+                    std::vector<int>* settled = nullptr);
+    void tracePath(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path, bool append) const;
+
+    int clusterOf(glm::ivec2 t) const;
+    void clusterBounds(int cluster, glm::ivec2& lo, glm::ivec2& hi) const;
+    void refreshClusters();
+    void findEntrances(int cluster, std::vector<Entrance>& out) const;
+    void scanBorder(glm::ivec2 first, glm::ivec2 along, glm::ivec2 across, int length,
+                    std::vector<Entrance>& out) const;
+    bool findPathHierarchical(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& path);
+
+    void buildFlowField(FlowField& field);
+    bool flowFieldStale(FlowField& field) const;
+};
+
+
+#endif //TACTICGAME_PATHFINDER_H
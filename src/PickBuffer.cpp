@@ -0,0 +1,108 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "PickBuffer.h"
+#include <glad/glad.h>
+
+PickBuffer::PickBuffer()
+        : fbo_(0),
+          colorBuffer_(0),
+          depthBuffer_(0),
+          next_(0),
+          pending_(0),
+          savedViewport_{0, 0, 0, 0}
+{
+    glGenRenderbuffers(1, &colorBuffer_);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_R32UI, 1, 1);
+    glGenRenderbuffers(1, &depthBuffer_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 1, 1);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fbo_);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer_);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    for (Readback& readback : readbacks_) {
+        glGenBuffers(1, &readback.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(std::uint32_t), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+PickBuffer::~PickBuffer()
+{
+    for (Readback& readback : readbacks_) {
+        if (readback.fence) {
+            glDeleteSync((GLsync)readback.fence);
+        }
+        glDeleteBuffers(1, &readback.pbo);
+    }
+    glDeleteFramebuffers(1, &fbo_);
+    glDeleteRenderbuffers(1, &colorBuffer_);
+    glDeleteRenderbuffers(1, &depthBuffer_);
+}
+
+void PickBuffer::begin()
+{
+    glGetIntegerv(GL_VIEWPORT, savedViewport_);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glViewport(0, 0, 1, 1);
+    const GLuint none[4] = {0, 0, 0, 0};
+    glClearBufferuiv(GL_COLOR, 0, none);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void PickBuffer::end(std::uint64_t frameIndex)
+{
+    // The slot about to be reused still holds an unfinished readback
+    Readback& readback = readbacks_[next_];
+    if (pending_ == kReadbacks) {
+        glDeleteSync((GLsync)readback.fence);
+        readback.fence = nullptr;
+        --pending_;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    glReadPixels(0, 0, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.frameIndex = frameIndex;
+    next_ = (next_ + 1) % kReadbacks;
+    ++pending_;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(savedViewport_[0], savedViewport_[1], savedViewport_[2], savedViewport_[3]);
+}
+
+bool PickBuffer::poll(std::uint32_t& id, std::uint64_t& frameIndex)
+{
+    if (pending_ == 0) {
+        return false;
+    }
+    Readback& readback = readbacks_[(next_ - pending_ + kReadbacks) % kReadbacks];
+    const GLenum status = glClientWaitSync((GLsync)readback.fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;
+    }
+    glDeleteSync((GLsync)readback.fence);
+    readback.fence = nullptr;
+    --pending_;
+
+    // The copy is done, so mapping doesn't wait
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(std::uint32_t), GL_MAP_READ_BIT);
+    id = 0;
+    if (data) {
+        id = *(const std::uint32_t*)data;
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    frameIndex = readback.frameIndex;
+    return data != nullptr;
+}
@@ -0,0 +1,57 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_PICKBUFFER_H
+#define TACTICGAME_PICKBUFFER_H
+
+
+#include <cstdint>
+
+// One-pixel ID target plus an asynchronous readback of it. The caller
+// renders object IDs (R32UI, 0 = nothing) with a pick-region projection
+// (pickRegionMatrix) between begin() and end(); end() queues a copy into a
+// pixel pack buffer with a fence, and poll() hands the ID back once the GPU
+// has got there, typically a frame later. Nothing ever waits on the GPU: a
+// readback that's still in flight when its buffer comes round again is
+// dropped.
+class PickBuffer
+{
+public:
+    PickBuffer();
+    ~PickBuffer();
+
+    PickBuffer(const PickBuffer&) = delete;
+    PickBuffer& operator=(const PickBuffer&) = delete;
+
+    // Binds and clears the target; restores the previous viewport at end()
+    void begin();
+    void end(std::uint64_t frameIndex);
+
+    // The oldest finished readback, if any
+    bool poll(std::uint32_t& id, std::uint64_t& frameIndex);
+    // Readbacks not yet returned by poll()
+    bool pending() const { return pending_ > 0; }
+
+private:
+    static constexpr int kReadbacks = 2;
+
+    struct Readback
+    {
+        unsigned int pbo = 0;
+        void* fence = nullptr; // GLsync
+        std::uint64_t frameIndex = 0;
+    };
+
+    unsigned int fbo_;
+    unsigned int colorBuffer_;
+    unsigned int depthBuffer_;
+    Readback readbacks_[kReadbacks];
+    int next_;    // slot end() writes
+    int pending_; // readbacks in flight, oldest at next_ - pending_
+
+    int savedViewport_[4];
+};
+
+
+#endif //TACTICGAME_PICKBUFFER_H
@@ -0,0 +1,125 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Picking.h"
+#include "TileMap.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PickRay screenRay(const glm::mat4& inverseViewProjection, const glm::vec2& cursor, const glm::vec2& viewportSize)
+{
+    const glm::vec2 ndc(2.0f * cursor.x / viewportSize.x - 1.0f,
+                        1.0f - 2.0f * cursor.y / viewportSize.y);
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+    glm::vec4 farPoint  = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint  /= farPoint.w;
+
+    PickRay ray;
+    ray.origin = glm::vec3(nearPoint);
+    ray.direction = glm::normalize(glm::vec3(farPoint) - glm::vec3(nearPoint));
+    return ray;
+}
+
+bool pickTile(const TileMap& map, const PickRay& ray, glm::ivec2& tile, glm::vec3* hit)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const int w = map.width();
+    const int d = map.depth();
+
+    // Grid space: tile (i, j) covers [i, i + 1] x [j, j + 1] in xz
+    const glm::vec3 o(ray.origin.x + w / 2.0f + 0.5f, ray.origin.y, ray.origin.z + d / 2.0f + 0.5f);
+    const glm::vec3 dir = ray.direction;
+
+    // Clip the ray to the board's footprint
+    float tMin = 0.0f;
+    float tMax = inf;
+    const float lo[2] = {0.0f, 0.0f};
+    const float hi[2] = {(float)w, (float)d};
+    const float origin[2] = {o.x, o.z};
+    const float delta[2] = {dir.x, dir.z};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (delta[axis] == 0.0f) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (lo[axis] - origin[axis]) / delta[axis];
+        float t1 = (hi[axis] - origin[axis]) / delta[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+    }
+    if (tMin > tMax) {
+        return false;
+    }
+
+    // Walk the tiles under the ray in order (Amanatides & Woo)
+    const glm::vec3 start = o + dir * tMin;
+    int i = std::min(std::max((int)std::floor(start.x), 0), w - 1);
+    int j = std::min(std::max((int)std::floor(start.z), 0), d - 1);
+    const int stepI = dir.x > 0.0f ? 1 : -1;
+    const int stepJ = dir.z > 0.0f ? 1 : -1;
+    const float tDeltaI = dir.x != 0.0f ? std::fabs(1.0f / dir.x) : inf;
+    const float tDeltaJ = dir.z != 0.0f ? std::fabs(1.0f / dir.z) : inf;
+    float tNextI = dir.x != 0.0f ? ((float)(i + (stepI > 0 ? 1 : 0)) - o.x) / dir.x : inf;
+    float tNextJ = dir.z != 0.0f ? ((float)(j + (stepJ > 0 ? 1 : 0)) - o.z) / dir.z : inf;
+
+    float tEnter = tMin;
+    while (tEnter <= tMax && i >= 0 && i < w && j >= 0 && j < d) {
+        const float tExit = std::min(std::min(tNextI, tNextJ), tMax);
+
+        if (map.hasTile(i, j)) {
+            // Where the ray's span over this tile overlaps the column's height
+            const float bottom = -0.5f;
+            const float top = map.topY(i, j);
+            float t1 = tEnter;
+            float t2 = tExit;
+            if (dir.y != 0.0f) {
+                float ta = (bottom - o.y) / dir.y;
+                float tb = (top - o.y) / dir.y;
+                if (ta > tb) std::swap(ta, tb);
+                t1 = std::max(t1, ta);
+                t2 = std::min(t2, tb);
+            } else if (o.y < bottom || o.y > top) {
+                t1 = inf;
+            }
+            if (t1 <= t2) {
+                tile = glm::ivec2(i, j);
+                if (hit) {
+                    *hit = ray.origin + ray.direction * t1;
+                }
+                return true;
+            }
+        }
+
+        // Nothing left below the board to hit
+        if (dir.y < 0.0f && o.y + dir.y * tExit < -0.5f) {
+            return false;
+        }
+
+        if (tNextI < tNextJ) {
+            i += stepI;
+            tEnter = tNextI;
+            tNextI += tDeltaI;
+        } else {
+            j += stepJ;
+            tEnter = tNextJ;
+            tNextJ += tDeltaJ;
+        }
+    }
+    return false;
+}
+
+glm::mat4 pickRegionMatrix(const glm::vec2& pixel, float size, const glm::vec2& viewportSize)
+{
+    glm::mat4 region(1.0f);
+    region = glm::translate(region, glm::vec3((viewportSize.x - 2.0f * pixel.x) / size,
+                                              (viewportSize.y - 2.0f * pixel.y) / size, 0.0f));
+    region = glm::scale(region, glm::vec3(viewportSize.x / size, viewportSize.y / size, 1.0f));
+    return region;
+}
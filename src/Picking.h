@@ -0,0 +1,53 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_PICKING_H
+#define TACTICGAME_PICKING_H
+
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class TileMap;
+
+// What's under a screen position
+enum class PickKind : std::uint8_t
+{
+    None,
+    Tile,
+    Unit,
+};
+
+struct PickResult
+{
+    PickKind kind = PickKind::None;
+    glm::ivec2 tile{-1, -1};   // Tile: the column that was hit
+    std::uint32_t unitId = 0;   // Unit: the RenderUnits::ids entry
+    std::uint64_t frameIndex = 0; // RenderFrame the pick was drawn in
+};
+
+struct PickRay
+{
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, -1.0f}; // unit length
+};
+
+// Ray through a cursor position (pixels, top-left origin as GLFW reports
+// them), from the near plane into the scene. Takes the inverse
+// view-projection (Camera caches it), so the isometric ortho camera and a
+// perspective one both work.
+PickRay screenRay(const glm::mat4& inverseViewProjection, const glm::vec2& cursor, const glm::vec2& viewportSize);
+
+// First tile column the ray hits, walking only the tiles under the ray
+// (grid DDA) rather than testing the whole board. `hit`, if given, gets the
+// world-space hit point on the column's top or side.
+bool pickTile(const TileMap& map, const PickRay& ray, glm::ivec2& tile, glm::vec3* hit = nullptr);
+
+// gluPickMatrix: maps a `size`-pixel square around `pixel` (GL window
+// coordinates, bottom-left origin) to the whole of clip space. Premultiply
+// a projection with it to render or cull just that region.
+glm::mat4 pickRegionMatrix(const glm::vec2& pixel, float size, const glm::vec2& viewportSize);
+
+
+#endif //TACTICGAME_PICKING_H
@@ -0,0 +1,232 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Profiler.h"
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+// --------------------------------------------------------------------------------
+// ScopeStats
+// --------------------------------------------------------------------------------
+void ScopeStats::add(double ms)
+{
+    last_ = ms;
+    if (samples_.size() < kWindow) {
+        samples_.push_back(ms);
+    } else {
+        samples_[next_] = ms;
+    }
+    next_ = (next_ + 1) % kWindow;
+}
+
+double ScopeStats::min() const
+{
+    if (samples_.empty()) return 0.0;
+    return *std::min_element(samples_.begin(), samples_.end());
+}
+
+double ScopeStats::avg() const
+{
+    if (samples_.empty()) return 0.0;
+    double sum = 0.0;
+    for (double s : samples_) sum += s;
+    return sum / (double)samples_.size();
+}
+
+double ScopeStats::p99() const
+{
+    if (samples_.empty()) return 0.0;
+    std::vector<double> sorted(samples_);
+    size_t k = (size_t)((sorted.size() - 1) * 0.99);
+    std::nth_element(sorted.begin(), sorted.begin() + (long)k, sorted.end());
+    return sorted[k];
+}
+
+// --------------------------------------------------------------------------------
+// Profiler
+// --------------------------------------------------------------------------------
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+        : capture_(false),
+          epoch_(std::chrono::steady_clock::now()),
+          frameStart_(epoch_),
+          inFrame_(false)
+{
+}
+
+void Profiler::beginFrame()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (inFrame_) {
+        addCpuSample("frame", frameStart_, now);
+    }
+    frameStart_ = now;
+    inFrame_ = true;
+}
+
+void Profiler::addCpuSample(const char* name, std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point end)
+{
+    using namespace std::chrono;
+    const double ms = duration<double, std::milli>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    cpu_[name].add(ms);
+
+    if (capture_ && trace_.size() < kMaxTraceEvents) {
+        TraceEvent e{};
+        e.name       = name;
+        e.startUs    = duration_cast<microseconds>(start - epoch_).count();
+        e.durationUs = duration_cast<microseconds>(end - start).count();
+        e.threadId   = (std::uint32_t)std::hash<std::thread::id>{}(std::this_thread::get_id());
+        trace_.push_back(e);
+    }
+}
+
+void Profiler::addGpuSample(const char* name, double ms)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    gpu_[name].add(ms);
+}
+
+void Profiler::setTraceCapture(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (enabled && !capture_) {
+        trace_.clear();
+    }
+    capture_ = enabled;
+}
+
+bool Profiler::traceCapture() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capture_;
+}
+
+void Profiler::logSummary() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto dump = [](const char* kind, const std::map<std::string, ScopeStats>& scopes) {
+        for (const auto& [name, stats] : scopes)
+        {
+            spdlog::info("[{}] {:<16} min {:7.3f} ms  avg {:7.3f} ms  p99 {:7.3f} ms  ({} samples)",
+                         kind, name, stats.min(), stats.avg(), stats.p99(), stats.count());
+        }
+    };
+    dump("cpu", cpu_);
+    dump("gpu", gpu_);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writer.StartObject();
+        writer.Key("traceEvents");
+        writer.StartArray();
+        for (const TraceEvent& e : trace_)
+        {
+            writer.StartObject();
+            writer.Key("name"); writer.String(e.name);
+            writer.Key("ph");   writer.String("X");
+            writer.Key("ts");   writer.Int64(e.startUs);
+            writer.Key("dur");  writer.Int64(e.durationUs);
+            writer.Key("pid");  writer.Int(0);
+            writer.Key("tid");  writer.Uint(e.threadId);
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        spdlog::error("Failed to write trace: {}", path);
+        return false;
+    }
+    out.write(buffer.GetString(), (std::streamsize)buffer.GetSize());
+    return true;
+}
+
+std::map<std::string, ScopeStats> Profiler::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, ScopeStats> all = cpu_;
+    for (const auto& [name, stats] : gpu_)
+    {
+        all["gpu." + name] = stats;
+    }
+    return all;
+}
+
+// --------------------------------------------------------------------------------
+// GpuTimer
+// --------------------------------------------------------------------------------
+GpuTimer::GpuTimer(const char* name)
+        : name_(name),
+          queries_{0, 0},
+          pending_{false, false},
+          current_(0)
+{
+    glGenQueries(2, queries_);
+}
+
+GpuTimer::~GpuTimer()
+{
+    glDeleteQueries(2, queries_);
+}
+
+void GpuTimer::begin()
+{
+    // Still waiting on this slot from two frames ago: skip timing this frame
+    // rather than overwrite a query the driver hasn't resolved
+    if (pending_[current_]) {
+        return;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, queries_[current_]);
+}
+
+void GpuTimer::end()
+{
+    if (pending_[current_]) {
+        current_ ^= 1;
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    pending_[current_] = true;
+    current_ ^= 1;
+}
+
+void GpuTimer::collect()
+{
+    for (int slot = 0; slot < 2; ++slot)
+    {
+        if (!pending_[slot]) {
+            continue;
+        }
+        GLint available = 0;
+        glGetQueryObjectiv(queries_[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queries_[slot], GL_QUERY_RESULT, &ns);
+        pending_[slot] = false;
+        Profiler::instance().addGpuSample(name_, (double)ns / 1.0e6);
+    }
+}
@@ -0,0 +1,147 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_PROFILER_H
+#define TACTICGAME_PROFILER_H
+
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Rolling window of timings (milliseconds) for one named scope
+class ScopeStats
+{
+public:
+    static constexpr size_t kWindow = 240;
+
+    void add(double ms);
+
+    size_t count() const { return samples_.size(); }
+    double min() const;
+    double avg() const;
+    double p99() const;
+    double last() const { return last_; }
+
+private:
+    std::vector<double> samples_; // ring of at most kWindow entries
+    size_t next_ = 0;
+    double last_ = 0.0;
+};
+
+// Collects CPU scope timings and GPU pass timings, keeps per-scope rolling
+// stats and an optional Chrome trace ("chrome://tracing" / Perfetto).
+// Thread safe, so worker threads can use ProfileScope too.
+class Profiler
+{
+public:
+    static Profiler& instance();
+
+    // Call once per frame; ends the previous frame's "frame" sample
+    void beginFrame();
+
+    void addCpuSample(const char* name, std::chrono::steady_clock::time_point start,
+                      std::chrono::steady_clock::time_point end);
+    void addGpuSample(const char* name, double ms);
+
+    // Record every CPU sample as a trace event until stopped (bounded)
+    void setTraceCapture(bool enabled);
+    bool traceCapture() const;
+
+    // min / avg / p99 for every scope through spdlog
+    void logSummary() const;
+    bool writeChromeTrace(const std::string& path) const;
+
+    std::map<std::string, ScopeStats> snapshot() const;
+
+private:
+    Profiler();
+
+    struct TraceEvent
+    {
+        const char* name;
+        std::int64_t startUs;
+        std::int64_t durationUs;
+        std::uint32_t threadId;
+    };
+    static constexpr size_t kMaxTraceEvents = 1 << 20;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, ScopeStats> cpu_;
+    std::map<std::string, ScopeStats> gpu_;
+    std::vector<TraceEvent> trace_;
+    bool capture_;
+
+    std::chrono::steady_clock::time_point epoch_;
+    std::chrono::steady_clock::time_point frameStart_;
+    bool inFrame_;
+};
+
+// RAII CPU timer; string literals only (the name pointer is kept for traces)
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+            : name_(name), start_(std::chrono::steady_clock::now()) {}
+    ~ProfileScope()
+    {
+        Profiler::instance().addCpuSample(name_, start_, std::chrono::steady_clock::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+// GL_TIME_ELAPSED timer for one render pass. Two query objects are used in
+// turn: the one written this frame is read back next frame, and only if the
+// driver reports it available, so collecting never stalls the pipeline.
+class GpuTimer
+{
+public:
+    explicit GpuTimer(const char* name);
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    void begin();
+    void end();
+
+    // Report the previous frame's result to the Profiler if it's ready
+    void collect();
+
+private:
+    const char* name_;
+    unsigned int queries_[2];
+    bool pending_[2];
+    int current_;
+};
+
+// RAII begin()/end() around a GPU pass
+class GpuScope
+{
+public:
+    explicit GpuScope(GpuTimer& timer) : timer_(timer) { timer_.begin(); }
+    ~GpuScope() { timer_.end(); }
+
+    GpuScope(const GpuScope&) = delete;
+    GpuScope& operator=(const GpuScope&) = delete;
+
+private:
+    GpuTimer& timer_;
+};
+
+
+#endif //TACTICGAME_PROFILER_H
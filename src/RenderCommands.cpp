@@ -0,0 +1,113 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "RenderCommands.h"
+#include "UnitStore.h"
+#include <chrono>
+#include <utility>
+
+void RenderUnits::clear()
+{
+    positions.clear();
+    scales.clear();
+    facings.clear();
+    teams.clear();
+    ids.clear();
+}
+
+void RenderUnits::copyFrom(const UnitStore& store)
+{
+    scales = store.scales();
+    facings = store.facings();
+    teams = store.teams();
+    ids.resize(teams.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = (std::uint32_t)i;
+    }
+}
+
+void RenderUnits::push(const glm::vec3& position, float scale, const glm::vec2& facing, std::uint8_t team,
+                       std::uint32_t id)
+{
+    positions.push_back(position);
+    scales.push_back(scale);
+    facings.push_back(facing);
+    teams.push_back(team);
+    ids.push_back(id);
+}
+
+void RenderFrame::clear()
+{
+    commands.clear();
+    views.clear();
+    units.clear();
+    tileEdits.clear();
+    fog.clear();
+}
+
+void RenderFrame::setView(const SceneView& view)
+{
+    commands.push_back(RenderCommand{RenderCommandType::SetView, (std::uint32_t)views.size()});
+    views.push_back(view);
+}
+
+void RenderHandoff::submit(RenderFrame& frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (hasFrame_ && !slot_.tileEdits.empty()) {
+            // The dropped frame's edits still have to reach the render map
+            frame.tileEdits.insert(frame.tileEdits.begin(), slot_.tileEdits.begin(), slot_.tileEdits.end());
+        }
+        if (hasFrame_ && frame.fog.empty() && !slot_.fog.empty()) {
+            frame.fog.swap(slot_.fog);
+        }
+        if (hasFrame_ && frame.pickPixel.x < 0 && slot_.pickPixel.x >= 0) {
+            // Nor may a pick asked for in it go missing
+            frame.pickPixel = slot_.pickPixel;
+        }
+        std::swap(slot_, frame);
+        hasFrame_ = true;
+    }
+    ready_.notify_one();
+    frame.clear();
+}
+
+bool RenderHandoff::acquire(RenderFrame& frame)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [this]() { return hasFrame_ || closed_; });
+    if (closed_) {
+        return false;
+    }
+    std::swap(slot_, frame);
+    hasFrame_ = false;
+    lock.unlock();
+    consumed_.notify_one();
+    return true;
+}
+
+bool RenderHandoff::waitForFrame(double timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return ready_.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs),
+                           [this]() { return hasFrame_ || closed_; });
+}
+
+void RenderHandoff::waitConsumed(double timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    consumed_.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs),
+                       [this]() { return !hasFrame_ || closed_; });
+}
+
+void RenderHandoff::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    ready_.notify_all();
+    consumed_.notify_all();
+}
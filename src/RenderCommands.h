@@ -0,0 +1,139 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_RENDERCOMMANDS_H
+#define TACTICGAME_RENDERCOMMANDS_H
+
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "ShadowMaps.h"
+
+class UnitStore;
+
+// Unit components the renderer needs, copied out of UnitStore's dense
+// arrays (positions are the interpolated render positions)
+struct RenderUnits
+{
+    std::vector<glm::vec3> positions;
+    std::vector<float> scales;
+    std::vector<glm::vec2> facings;
+    std::vector<std::uint8_t> teams;
+    // Caller's id per unit (below 2^24), reported back by GPU picking
+    std::vector<std::uint32_t> ids;
+
+    size_t size() const { return positions.size(); }
+    void clear();
+    // Copies everything but positions from the store; positions must
+    // already hold the same number of units
+    void copyFrom(const UnitStore& store);
+    void push(const glm::vec3& position, float scale, const glm::vec2& facing, std::uint8_t team,
+              std::uint32_t id = 0);
+};
+
+// Board edits the renderer's own copy of the map must replay
+struct TileEdit
+{
+    int i;
+    int j;
+    float height;
+    int type;
+};
+
+enum class RenderCommandType : std::uint8_t
+{
+    SetView,     // index = RenderFrame::views entry; updates uniforms, culls
+    DrawTerrain,
+    DrawUnits,
+};
+
+struct RenderCommand
+{
+    RenderCommandType type;
+    std::uint32_t index;
+};
+
+// Everything one frame draws, built by the simulation thread and consumed
+// by the render thread. Plain data: no GL, and no references into live
+// game state, so the two sides never touch the same memory.
+struct RenderFrame
+{
+    std::vector<RenderCommand> commands;
+    std::vector<SceneView> views;
+    RenderUnits units;
+    std::vector<TileEdit> tileEdits; // applied before the commands, in order
+    // New fog-of-war mask (FogOfWar::buildMask layout), empty = unchanged
+    std::vector<std::uint8_t> fog;
+
+    bool chunkedTerrain = true;
+    bool culling = true;
+    ShadowQuality shadowQuality = ShadowQuality::Pcf3x3;
+    bool depthPrepass = false;
+    // Pixel to pick (GL window coordinates, bottom-left origin), -1 = none;
+    // the result comes back through RenderThread::latestPick()
+    glm::ivec2 pickPixel{-1, -1};
+    // Tile column drawn highlighted, -1 = none
+    glm::ivec2 highlightTile{-1, -1};
+    int viewportWidth = 0;
+    int viewportHeight = 0;
+    // Vblanks per swap (glfwSwapInterval), 0 = vsync off
+    int swapInterval = 1;
+    // Counts submitted frames from 1; picks carry the index of the frame
+    // they were drawn in (PickResult::frameIndex)
+    std::uint64_t frameIndex = 0;
+
+    // Empties the lists, keeping their capacity
+    void clear();
+
+    void setView(const SceneView& view);
+    void drawTerrain() { commands.push_back(RenderCommand{RenderCommandType::DrawTerrain, 0}); }
+    void drawUnits() { commands.push_back(RenderCommand{RenderCommandType::DrawUnits, 0}); }
+};
+
+// Double-buffered handoff between the simulation and render threads. Each
+// side keeps its own RenderFrame and exchanges it with the shared slot by
+// swapping, so handing over a frame is O(1) and neither side copies.
+//
+// If the render thread falls behind, a newer frame replaces the unconsumed
+// one (the simulation never waits on rendering), but tile edits, the latest
+// fog mask and a pending pick request carry over so the render side never
+// misses a change.
+class RenderHandoff
+{
+public:
+    // Swaps `frame` into the shared slot; `frame` comes back cleared and
+    // ready to fill with the next frame
+    void submit(RenderFrame& frame);
+
+    // Waits for a frame newer than the last one taken and swaps it into
+    // `frame`. Returns false once close() has been called.
+    bool acquire(RenderFrame& frame);
+
+    // Waits up to timeoutMs for acquire() to have a frame (or for close());
+    // true if it has one
+    bool waitForFrame(double timeoutMs);
+
+    // Blocks the submitting side until the render thread has taken the
+    // last frame, or until timeoutMs passes; paces simulation to display
+    // rate without ever blocking on a slow frame for long
+    void waitConsumed(double timeoutMs);
+
+    void close();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable consumed_;
+    RenderFrame slot_;
+    bool hasFrame_ = false;
+    bool closed_ = false;
+};
+
+
+#endif //TACTICGAME_RENDERCOMMANDS_H
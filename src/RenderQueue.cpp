@@ -0,0 +1,48 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "RenderQueue.h"
+#include <algorithm>
+
+std::uint64_t RenderQueue::makeKey(RenderPass pass, std::uint32_t program, std::uint32_t material,
+                                   std::uint32_t mesh, float depth)
+{
+    const float clamped = std::min(std::max(depth, 0.0f), 1.0f);
+    const std::uint64_t quantized = (std::uint64_t)(clamped * (float)0xFFFFFF);
+    return ((std::uint64_t)pass & 0xFu) << 60
+         | ((std::uint64_t)program & 0xFFu) << 52
+         | ((std::uint64_t)material & 0xFFFu) << 40
+         | ((std::uint64_t)mesh & 0xFFFFu) << 24
+         | quantized;
+}
+
+void RenderQueue::sort()
+{
+    const size_t count = items_.size();
+    if (count < 2) {
+        return;
+    }
+    scratch_.resize(count);
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (const DrawItem& item : items_) {
+            ++histogram[(item.key >> shift) & 0xFFu];
+        }
+        // Every key shares this digit: nothing to reorder
+        if (histogram[(items_[0].key >> shift) & 0xFFu] == count) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            const size_t n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+        for (const DrawItem& item : items_) {
+            scratch_[histogram[(item.key >> shift) & 0xFFu]++] = item;
+        }
+        items_.swap(scratch_);
+    }
+}
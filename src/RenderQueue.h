@@ -0,0 +1,71 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_RENDERQUEUE_H
+#define TACTICGAME_RENDERQUEUE_H
+
+
+#include <cstdint>
+#include <vector>
+
+// Passes in submission order
+enum class RenderPass : std::uint8_t
+{
+    DepthPrepass, // depth only, front to back
+    Opaque,
+};
+
+// One queued draw. `kind` and `index` are the submitter's own (what to draw
+// and which one); the queue only orders by key.
+struct DrawItem
+{
+    std::uint64_t key;
+    std::uint32_t kind;
+    std::uint32_t index;
+};
+
+// Collects a frame's draws and orders them by a 64-bit key so the submitter
+// only changes state between runs of items that need it. From the top bit:
+//
+//   pass (4) | program (8) | material (12) | mesh (16) | depth (24)
+//
+// Depth is [0, 1] NDC-style depth quantized, so within one state the draws
+// go front to back. `mesh` is a submitter-chosen id for the VAO to bind,
+// not a GL name: draws that bind their own VAO (terrain chunks) share one
+// id, so depth alone orders them, in the pre-pass and the opaque pass.
+//
+// No GL here: the submitter decodes the fields and binds.
+class RenderQueue
+{
+public:
+    static std::uint64_t makeKey(RenderPass pass, std::uint32_t program, std::uint32_t material,
+                                 std::uint32_t mesh, float depth);
+
+    static RenderPass pass(std::uint64_t key) { return (RenderPass)(key >> 60); }
+    static std::uint32_t program(std::uint64_t key) { return (std::uint32_t)(key >> 52) & 0xFFu; }
+    static std::uint32_t material(std::uint64_t key) { return (std::uint32_t)(key >> 40) & 0xFFFu; }
+    static std::uint32_t mesh(std::uint64_t key) { return (std::uint32_t)(key >> 24) & 0xFFFFu; }
+
+    void push(std::uint64_t key, std::uint32_t kind, std::uint32_t index)
+    {
+        items_.push_back(DrawItem{key, kind, index});
+    }
+
+    // Stable LSD radix sort on the key, 8 bits a pass; passes where every
+    // key has the same digit are skipped, so a queue that only differs in
+    // a few fields sorts in a few passes
+    void sort();
+
+    const std::vector<DrawItem>& items() const { return items_; }
+    bool empty() const { return items_.empty(); }
+    // Keeps capacity; called once the items are submitted
+    void clear() { items_.clear(); }
+
+private:
+    std::vector<DrawItem> items_;
+    std::vector<DrawItem> scratch_;
+};
+
+
+#endif //TACTICGAME_RENDERQUEUE_H
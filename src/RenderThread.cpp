@@ -0,0 +1,133 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "RenderThread.h"
+#include "FileWatcher.h"
+#include "SceneRenderer.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <memory>
+#include <utility>
+
+RenderThread::RenderThread(GLFWwindow* window, const TileMap& map, std::shared_ptr<const MapFile> bakedMap)
+        : window_(window),
+          map_(map),
+          bakedMap_(std::move(bakedMap)),
+          presented_(0),
+          pendingWork_(true) // until the first frame says otherwise
+{
+}
+
+RenderThread::~RenderThread()
+{
+    stop();
+}
+
+void RenderThread::enableHotReload()
+{
+    if (!watcher_) {
+        watcher_ = std::make_unique<FileWatcher>();
+        // An idle main loop sleeps in the event queue; wake it so it sends
+        // the frame that picks the change up
+        watcher_->setOnChange([] { glfwPostEmptyEvent(); });
+    }
+}
+
+bool RenderThread::hasPendingWork() const
+{
+    return pendingWork_.load(std::memory_order_relaxed) || (watcher_ && watcher_->hasChanges());
+}
+
+void RenderThread::start()
+{
+    if (!thread_.joinable()) {
+        thread_ = std::thread(&RenderThread::run, this);
+    }
+}
+
+void RenderThread::stop()
+{
+    handoff_.close();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+PickResult RenderThread::latestPick() const
+{
+    std::lock_guard<std::mutex> lock(pickMutex_);
+    return latestPick_;
+}
+
+void RenderThread::publishPick(SceneRenderer& sceneRenderer)
+{
+    PickResult pick;
+    if (!sceneRenderer.takePick(pick)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pickMutex_);
+        latestPick_ = pick;
+    }
+    // The caller may be asleep in the event queue; the hover can change
+    glfwPostEmptyEvent();
+}
+
+void RenderThread::run()
+{
+    glfwMakeContextCurrent(window_);
+
+    glEnable(GL_DEPTH_TEST);
+
+    // Background
+    glClearColor(0.7f, 0.7f, 0.7f, 1.0f);
+
+    // Terrain, units and all their GL resources, created on this thread
+    auto sceneRenderer = std::make_unique<SceneRenderer>(map_, bakedMap_.get());
+    bakedMap_.reset();
+    if (watcher_) {
+        sceneRenderer->watchResources(*watcher_);
+    }
+
+    RenderFrame frame;
+    int viewportWidth = 0;
+    int viewportHeight = 0;
+    int swapInterval = -1;
+    while (handoff_.acquire(frame)) {
+        for (const TileEdit& edit : frame.tileEdits) {
+            map_.setTile(edit.i, edit.j, edit.height, edit.type);
+        }
+        if (frame.viewportWidth != viewportWidth || frame.viewportHeight != viewportHeight) {
+            viewportWidth = frame.viewportWidth;
+            viewportHeight = frame.viewportHeight;
+            glViewport(0, 0, viewportWidth, viewportHeight);
+        }
+        if (frame.swapInterval != swapInterval) {
+            swapInterval = frame.swapInterval;
+            glfwSwapInterval(swapInterval);
+        }
+        sceneRenderer->setChunkedTerrain(frame.chunkedTerrain);
+        sceneRenderer->setCulling(frame.culling);
+        sceneRenderer->setShadowQuality(frame.shadowQuality);
+        sceneRenderer->setDepthPrepass(frame.depthPrepass);
+
+        sceneRenderer->execute(frame);
+        publishPick(*sceneRenderer);
+        pendingWork_.store(sceneRenderer->hasPendingWork(), std::memory_order_relaxed);
+
+        glfwSwapBuffers(window_);
+        presented_.fetch_add(1, std::memory_order_relaxed);
+
+        // A pick still on the GPU is collected here, between frames, so an
+        // idle caller gets it without drawing again just to poll
+        while (sceneRenderer->pickPending() && !handoff_.waitForFrame(1.0)) {
+            sceneRenderer->collectPicks();
+            publishPick(*sceneRenderer);
+        }
+    }
+
+    // GL objects must go before the context is released
+    sceneRenderer.reset();
+    glfwMakeContextCurrent(nullptr);
+}
@@ -0,0 +1,84 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_RENDERTHREAD_H
+#define TACTICGAME_RENDERTHREAD_H
+
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Picking.h"
+#include "RenderCommands.h"
+#include "TileMap.h"
+
+class FileWatcher;
+class MapFile;
+class SceneRenderer;
+struct GLFWwindow;
+
+// Dedicated thread that owns the window's GL context and everything drawn
+// with it. The simulation thread keeps input and game state, fills a
+// RenderFrame each frame and submit()s it; the render thread replays tile
+// edits into its own copy of the map, runs the command list and swaps.
+//
+// The context must not be current on the calling thread when start() is
+// called; the render thread makes it current for its lifetime and releases
+// it before stop() returns.
+class RenderThread
+{
+public:
+    // `bakedMap`, if given, is the file `map` was loaded from; its chunk
+    // meshes are uploaded as-is and the mapping released once they are
+    RenderThread(GLFWwindow* window, const TileMap& map, std::shared_ptr<const MapFile> bakedMap = nullptr);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Watch the renderer's shader and texture files and reload them when
+    // they change (SceneRenderer::watchResources). Call before start().
+    void enableHotReload();
+
+    void start();
+    // Finishes the frame in flight, frees the GL resources, joins
+    void stop();
+
+    // Hands the frame to the render thread; `frame` comes back cleared
+    void submit(RenderFrame& frame) { handoff_.submit(frame); }
+    // Paces the caller to the render thread, waiting at most timeoutMs
+    void waitForRender(double timeoutMs) { handoff_.waitConsumed(timeoutMs); }
+
+    // Most recent GPU pick result (kind None until one arrives)
+    PickResult latestPick() const;
+
+    // Frames presented so far
+    std::uint64_t framesPresented() const { return presented_.load(std::memory_order_relaxed); }
+
+    // The last frame left work that needs further frames (textures
+    // streaming, a shader rebuild) or a watched file changed, so the caller
+    // shouldn't go idle
+    bool hasPendingWork() const;
+
+private:
+    GLFWwindow* window_;
+    TileMap map_; // render-side copy, kept in sync through TileEdits
+    std::shared_ptr<const MapFile> bakedMap_;
+    RenderHandoff handoff_;
+    std::thread thread_;
+    std::atomic<std::uint64_t> presented_;
+    std::atomic<bool> pendingWork_;
+    mutable std::mutex pickMutex_;
+    PickResult latestPick_;
+    std::unique_ptr<FileWatcher> watcher_;
+
+    void run();
+    // Moves a finished pick to latestPick() and wakes the caller
+    void publishPick(SceneRenderer& sceneRenderer);
+};
+
+
+#endif //TACTICGAME_RENDERTHREAD_H
@@ -0,0 +1,169 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Replay.h"
+#include "Snapshot.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr std::uint64_t kSectionAlign = 16;
+
+std::uint64_t alignUp(std::uint64_t value)
+{
+    return (value + kSectionAlign - 1) & ~(kSectionAlign - 1);
+}
+
+bool sectionInBounds(std::uint64_t offset, std::uint64_t bytes, std::uint64_t fileSize)
+{
+    return offset % kSectionAlign == 0 && offset <= fileSize && bytes <= fileSize - offset;
+}
+
+} // namespace
+
+ReplayRecorder::ReplayRecorder(std::vector<std::uint8_t> initialSnapshot)
+        : snapshot_(std::move(initialSnapshot)),
+          firstTick_(0),
+          tickCount_(0),
+          lastInput_(-1)
+{
+    if (snapshot_.size() >= sizeof(SnapshotHeader)) {
+        firstTick_ = reinterpret_cast<const SnapshotHeader*>(snapshot_.data())->tick;
+    }
+}
+
+void ReplayRecorder::record(std::uint64_t tick, const SimInput& input, const SimCommand* commands, std::size_t count)
+{
+    ++tickCount_;
+    const int bits = input.bits();
+    if (bits == lastInput_ && count == 0) {
+        return;
+    }
+    lastInput_ = bits;
+
+    // A record holds at most 65535 commands; more go in follow-up records
+    // for the same tick
+    do {
+        const std::size_t batch = std::min<std::size_t>(count, std::numeric_limits<std::uint16_t>::max());
+        TickRecord record{};
+        record.tick = tick;
+        record.input = (std::uint8_t)bits;
+        record.commandCount = (std::uint16_t)batch;
+        records_.push_back(record);
+        commands_.insert(commands_.end(), commands, commands + batch);
+        commands += batch;
+        count -= batch;
+    } while (count > 0);
+}
+
+bool ReplayRecorder::save(const std::string& path, std::uint64_t finalHash) const
+{
+    ReplayHeader h{};
+    std::memcpy(h.magic, kReplayMagic, sizeof(kReplayMagic));
+    h.version        = kReplayVersion;
+    h.firstTick      = firstTick_;
+    h.tickCount      = tickCount_;
+    h.finalHash      = finalHash;
+    h.snapshotBytes  = snapshot_.size();
+    h.recordCount    = records_.size();
+    h.commandCount   = commands_.size();
+    h.snapshotOffset = alignUp(sizeof(ReplayHeader));
+    h.recordsOffset  = alignUp(h.snapshotOffset + snapshot_.size());
+    h.commandsOffset = alignUp(h.recordsOffset + records_.size() * sizeof(TickRecord));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        spdlog::error("Replay: cannot write {}", path);
+        return false;
+    }
+    std::uint64_t written = 0;
+    auto put = [&](std::uint64_t offset, const void* bytes, size_t count) {
+        static const char zeros[kSectionAlign] = {};
+        out.write(zeros, (std::streamsize)(offset - written));
+        out.write(static_cast<const char*>(bytes), (std::streamsize)count);
+        written = offset + count;
+    };
+    put(0, &h, sizeof(h));
+    put(h.snapshotOffset, snapshot_.data(), snapshot_.size());
+    put(h.recordsOffset, records_.data(), records_.size() * sizeof(TickRecord));
+    put(h.commandsOffset, commands_.data(), commands_.size() * sizeof(SimCommand));
+    if (!out) {
+        spdlog::error("Replay: write to {} failed", path);
+        return false;
+    }
+    spdlog::info("Replay: {} ticks, {} records, {} commands -> {}", tickCount_, records_.size(), commands_.size(), path);
+    return true;
+}
+
+std::unique_ptr<Replay> Replay::load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        spdlog::error("Replay: cannot open {}", path);
+        return nullptr;
+    }
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(ReplayHeader)) {
+        spdlog::error("Replay: {} is too small", path);
+        return nullptr;
+    }
+
+    auto replay = std::make_unique<Replay>();
+    ReplayHeader& h = replay->header_;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    const std::uint64_t size = bytes.size();
+    if (std::memcmp(h.magic, kReplayMagic, sizeof(kReplayMagic)) != 0 || h.version != kReplayVersion) {
+        spdlog::error("Replay: {} is not a version {} replay", path, kReplayVersion);
+        return nullptr;
+    }
+    if (h.recordCount > size / sizeof(TickRecord) || h.commandCount > size / sizeof(SimCommand)
+        || !sectionInBounds(h.snapshotOffset, h.snapshotBytes, size)
+        || !sectionInBounds(h.recordsOffset, h.recordCount * sizeof(TickRecord), size)
+        || !sectionInBounds(h.commandsOffset, h.commandCount * sizeof(SimCommand), size)) {
+        spdlog::error("Replay: {} has sections out of bounds", path);
+        return nullptr;
+    }
+
+    const char* base = bytes.data();
+    replay->snapshot_.assign(base + h.snapshotOffset, base + h.snapshotOffset + h.snapshotBytes);
+    replay->records_.resize(h.recordCount);
+    std::memcpy(replay->records_.data(), base + h.recordsOffset, h.recordCount * sizeof(TickRecord));
+    replay->commands_.resize(h.commandCount);
+    std::memcpy(replay->commands_.data(), base + h.commandsOffset, h.commandCount * sizeof(SimCommand));
+
+    std::uint64_t referenced = 0;
+    for (const TickRecord& record : replay->records_) {
+        referenced += record.commandCount;
+    }
+    if (referenced != h.commandCount) {
+        spdlog::error("Replay: {} records reference {} commands, file has {}", path, referenced, h.commandCount);
+        return nullptr;
+    }
+    return replay;
+}
+
+void Replay::play(Simulation& simulation) const
+{
+    SimInput input;
+    size_t nextRecord = 0;
+    size_t nextCommand = 0;
+    const std::uint64_t endTick = header_.firstTick + header_.tickCount;
+    while (simulation.tickCount() < endTick) {
+        const std::uint64_t tick = simulation.tickCount();
+        while (nextRecord < records_.size() && records_[nextRecord].tick <= tick) {
+            const TickRecord& record = records_[nextRecord++];
+            input = SimInput::fromBits(record.input);
+            for (std::uint16_t c = 0; c < record.commandCount; ++c) {
+                simulation.submit(commands_[nextCommand++]);
+            }
+        }
+        simulation.tick(input);
+    }
+}
@@ -0,0 +1,104 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_REPLAY_H
+#define TACTICGAME_REPLAY_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+
+class TileMap;
+
+// Replay log (.tgrp): the snapshot a match started from plus what every
+// tick was fed. Ticks are delta coded: a TickRecord is written only when
+// the input changes or commands arrive, and the input holds until the next
+// record. Sections are 16-byte aligned like the other binary formats.
+//
+//   ReplayHeader
+//   snapshot  uint8[snapshotBytes]     saveSnapshot() at the first tick
+//   records   TickRecord[recordCount]  ascending tick
+//   commands  SimCommand[commandCount] in record order
+constexpr char kReplayMagic[4] = {'T', 'G', 'R', 'P'};
+constexpr std::uint32_t kReplayVersion = 1;
+
+struct ReplayHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t firstTick;     // the snapshot's tick
+    std::uint64_t tickCount;     // ticks run after the snapshot
+    std::uint64_t finalHash;     // snapshotHash() after the last tick
+    std::uint64_t snapshotBytes;
+    std::uint64_t recordCount;
+    std::uint64_t commandCount;
+    std::uint64_t snapshotOffset;
+    std::uint64_t recordsOffset;
+    std::uint64_t commandsOffset;
+};
+static_assert(sizeof(ReplayHeader) == 80, "ReplayHeader layout is part of the replay format");
+
+struct TickRecord
+{
+    std::uint64_t tick;
+    std::uint8_t input;        // SimInput::bits()
+    std::uint8_t reserved;
+    std::uint16_t commandCount;
+    std::uint32_t reserved2;
+};
+static_assert(sizeof(TickRecord) == 16, "TickRecord layout is part of the replay format");
+
+// Attached to a Simulation with setRecorder(); collects the log in memory
+class ReplayRecorder
+{
+public:
+    // `initialSnapshot` is the state ticks are recorded from
+    explicit ReplayRecorder(std::vector<std::uint8_t> initialSnapshot);
+
+    // Called by Simulation::tick() before the tick runs
+    void record(std::uint64_t tick, const SimInput& input, const SimCommand* commands, std::size_t count);
+
+    std::uint64_t tickCount() const { return tickCount_; }
+
+    // Writes the log; `finalHash` is snapshotHash() of the state after the
+    // last recorded tick, which replays are checked against
+    bool save(const std::string& path, std::uint64_t finalHash) const;
+
+private:
+    std::vector<std::uint8_t> snapshot_;
+    std::uint64_t firstTick_;
+    std::uint64_t tickCount_;
+    std::vector<TickRecord> records_;
+    std::vector<SimCommand> commands_;
+    int lastInput_; // -1 before the first tick
+};
+
+// A loaded replay log
+class Replay
+{
+public:
+    // Null if the file can't be read or isn't a valid log
+    static std::unique_ptr<Replay> load(const std::string& path);
+
+    const ReplayHeader& header() const { return header_; }
+    const std::vector<std::uint8_t>& snapshot() const { return snapshot_; }
+
+    // Runs every recorded tick on `simulation`, which must have been
+    // restored from snapshot(); no clocks, as fast as the CPU goes
+    void play(Simulation& simulation) const;
+
+private:
+    ReplayHeader header_{};
+    std::vector<std::uint8_t> snapshot_;
+    std::vector<TickRecord> records_;
+    std::vector<SimCommand> commands_;
+};
+
+
+#endif //TACTICGAME_REPLAY_H
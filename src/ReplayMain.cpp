@@ -0,0 +1,81 @@
+//
+// Created by User on 14/10/2026.
+//
+// TacticReplay: re-simulates a recorded match headless (no window, no GL)
+// as fast as the CPU allows and checks the final state against the hash
+// the recording ended with. Exit code 0 = the replay matched.
+//
+//   TacticReplay match.tgrp [--repeat 10]
+//
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Replay.h"
+#include "Simulation.h"
+#include "Snapshot.h"
+#include "TileMap.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: TacticReplay match.tgrp [--repeat N]\n");
+        return 2;
+    }
+    const std::string path = argv[1];
+    int repeat = 1;
+    for (int i = 2; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::unique_ptr<Replay> replay = Replay::load(path);
+    if (!replay) {
+        return 2;
+    }
+    const std::vector<std::uint8_t>& initial = replay->snapshot();
+    std::unique_ptr<TileMap> board = loadSnapshotBoard(initial.data(), initial.size());
+    if (!board) {
+        spdlog::error("{}: bad snapshot", path);
+        return 2;
+    }
+
+    // Each run starts from the snapshot on a pristine board, so repeats
+    // also check that nothing outside the snapshot leaks into the result
+    bool matched = true;
+    std::vector<std::uint8_t> final;
+    for (int run = 0; run < repeat; ++run) {
+        TileMap map = *board;
+        Simulation simulation(map);
+        if (!loadSnapshotState(initial.data(), initial.size(), simulation)) {
+            spdlog::error("{}: bad snapshot", path);
+            return 2;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        replay->play(simulation);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        saveSnapshot(map, simulation, final);
+        const std::uint64_t hash = snapshotHash(final);
+        const bool ok = hash == replay->header().finalHash;
+        matched = matched && ok;
+        std::printf("{\"run\": %d, \"ticks\": %llu, \"seconds\": %.6f, \"ticksPerSecond\": %.0f, "
+                    "\"hash\": \"%016llx\", \"match\": %s}\n",
+                    run, (unsigned long long)replay->header().tickCount, seconds,
+                    seconds > 0.0 ? (double)replay->header().tickCount / seconds : 0.0,
+                    (unsigned long long)hash, ok ? "true" : "false");
+    }
+    return matched ? 0 : 1;
+}
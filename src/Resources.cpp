@@ -0,0 +1,46 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Resources.h"
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+static std::string& rootStorage()
+{
+    static std::string root = "resources";
+    return root;
+}
+
+void setResourceRoot(std::string root)
+{
+    while (root.size() > 1 && (root.back() == '/' || root.back() == '\\')) {
+        root.pop_back();
+    }
+    rootStorage() = std::move(root);
+}
+
+const std::string& resourceRoot()
+{
+    return rootStorage();
+}
+
+std::string resourcePath(const std::string& relative)
+{
+    return rootStorage() + "/" + relative;
+}
+
+bool readTextFile(const std::string& path, std::string& text)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        spdlog::error("Can't read {}", path);
+        return false;
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    text = contents.str();
+    return true;
+}
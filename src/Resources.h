@@ -0,0 +1,25 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_RESOURCES_H
+#define TACTICGAME_RESOURCES_H
+
+
+#include <string>
+
+// Directory resource paths resolve against. Defaults to "resources", the
+// copy CMake places next to the binaries; hot-reload runs point it at the
+// source tree (TACTICGAME_SOURCE_RESOURCES) so edits there are picked up.
+// Set it before anything loads.
+void setResourceRoot(std::string root);
+const std::string& resourceRoot();
+
+// `relative` ("shaders/scene.vert") under the resource root
+std::string resourcePath(const std::string& relative);
+
+// The whole file as text; false (and logged) if it can't be read
+bool readTextFile(const std::string& path, std::string& text);
+
+
+#endif //TACTICGAME_RESOURCES_H
@@ -0,0 +1,1085 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "SceneRenderer.h"
+#include "TileMap.h"
+#include "Frustum.h"
+#include "PickBuffer.h"
+#include "Picking.h"
+#include "InstanceKernels.h"
+#include "FileWatcher.h"
+#include "Resources.h"
+#include "ShaderCache.h"
+#include "ShadowMaps.h"
+#include "StreamBuffer.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+// --------------------------------------------------------------------------------
+// Shader sources under resources/shaders, as (vertex, fragment) pairs. The
+// watcher maps changed files back to these.
+// --------------------------------------------------------------------------------
+static const char* kProgramFiles[][2] = {
+        {"shaders/scene.vert", "shaders/scene.frag"},   // kProgramScene
+        {"shaders/shadow.vert", "shaders/depth.frag"},  // kProgramShadow
+        {"shaders/depth.vert", "shaders/depth.frag"},   // kProgramDepth
+        {"shaders/pick.vert", "shaders/pick.frag"},     // kProgramPick
+};
+
+static const std::uint32_t kPickTileBit = 0x80000000u;
+static const std::uint32_t kPickUnitBit = 0x40000000u;
+
+// --------------------------------------------------------------------------------
+// Unit instance record: mat3x4 transform, team, pick id, padded to 16 floats
+// --------------------------------------------------------------------------------
+static const size_t kUnitInstanceFloats = 16;
+
+// --------------------------------------------------------------------------------
+// Unit sphere LODs, finest first, and the smallest on-screen diameter (in
+// pixels) each is used down to. Stacks match sectors, so LOD 1 is the
+// original 16x16 sphere.
+// --------------------------------------------------------------------------------
+static const int kUnitLodSectors[SceneRenderer::kUnitLodCount] = {32, 16, 8, 4};
+static const float kUnitLodMinPixels[SceneRenderer::kUnitLodCount] = {96.0f, 32.0f, 12.0f, 0.0f};
+
+// --------------------------------------------------------------------------------
+// Point the unit instance attributes at one kUnitInstanceFloats record per
+// unit: transform rows (attributes 5-7), the team (attribute 4) and the
+// pick id (attribute 8), all with divisor 1. Expects the mesh registry's
+// VAO bound.
+// --------------------------------------------------------------------------------
+static void bindUnitInstances(unsigned int buffer, std::size_t offset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    const GLsizei stride = kUnitInstanceFloats * sizeof(float);
+    for (int row = 0; row < 3; ++row) {
+        glVertexAttribPointer(5 + row, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offset + row * 4 * sizeof(float)));
+        glEnableVertexAttribArray(5 + row);
+        glVertexAttribDivisor(5 + row, 1);
+    }
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(offset + kTransformFloats * sizeof(float)));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(offset + (kTransformFloats + 1) * sizeof(float)));
+    glEnableVertexAttribArray(8);
+    glVertexAttribDivisor(8, 1);
+}
+
+// --------------------------------------------------------------------------------
+// Unit colours, index = team
+// --------------------------------------------------------------------------------
+static const glm::vec3 kTeamColors[4] = {
+        {1.0f, 0.2f, 0.2f}, // red, the player's team
+        {0.2f, 0.4f, 1.0f},
+        {0.2f, 0.9f, 0.3f},
+        {0.9f, 0.8f, 0.2f},
+};
+
+// --------------------------------------------------------------------------------
+// Tile materials: index = TileMap tile type = texture array layer
+// --------------------------------------------------------------------------------
+static const char* kTileMaterialPaths[] = {
+        "textures/texture_08.png",
+        "textures/texture_01.png",
+        "textures/texture_02.png",
+};
+static const int kTileMaterialSize = 1024;
+
+// --------------------------------------------------------------------------------
+// SceneRenderer
+// --------------------------------------------------------------------------------
+SceneRenderer::SceneRenderer(const TileMap& map, const MapFile* baked)
+        : map_(map),
+          lightDirection_(glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f))),
+          lightColor_(1.0f, 1.0f, 1.0f),
+          skyColor_(0.5f, 0.7f, 1.0f),
+          skyStrength_(0.2f),
+          watcher_(nullptr),
+          cubeVAO_(0), cubeVBO_(0), cubeEBO_(0),
+          sphereRadius_(kUnitRadius),
+          viewportHeight_(0),
+          pixelsPerUnit_(0.0f),
+          tileMaterials_(0),
+          chunkedTerrain_(true),
+          gridRevision_(0),
+          fogTexture_(0),
+          fogEnabled_(false),
+          depthPrepass_(false),
+          viewportWidth_(0),
+          highlightRect_(1.0f, 1.0f, 0.0f, 0.0f),
+          pickReady_(false),
+          shadowQuality_(ShadowQuality::Pcf3x3),
+          shadowBoundsValid_(false),
+          shadowBoundsRevision_(0),
+          culling_(true),
+          unitInstanceBuffer_(0),
+          unitInstanceOffset_(0),
+          unitLodCounts_{},
+          unitLodStart_{},
+          unitCasterStart_(0),
+          unitCasterCount_(0)
+{
+    // Ring for everything rewritten per frame (uniforms, unit instances)
+    stream_ = std::make_unique<StreamBuffer>();
+
+    // Per-frame camera/light block, shared by every program
+    frameUniforms_ = std::make_unique<FrameUniformBuffer>(*stream_);
+
+    // Build every program and shader variant up front, from the binary
+    // cache when the driver has seen these sources before
+    shaderCache_ = std::make_unique<ShaderCache>();
+    for (int program = 0; program < kProgramCount; ++program) {
+        for (const char* file : kProgramFiles[program]) {
+            const std::string path = resourcePath(file);
+            if (shaderSources_.find(path) == shaderSources_.end()) {
+                readTextFile(path, shaderSources_[path]);
+            }
+        }
+        std::unique_ptr<ShaderVariants> built = makeProgram((ShaderProgram)program);
+        built->build(shaderCache_.get());
+        installProgram((ShaderProgram)program, std::move(built));
+    }
+
+    // Cached terrain map + per-frame unit overlay, drawn with shadowShader_
+    shadows_ = std::make_unique<ShadowMaps>();
+
+    // Object IDs under the cursor (pickShader_), read back a frame later
+    pickBuffer_ = std::make_unique<PickBuffer>();
+
+    createCube();
+
+    // Tile VAOs enable either attribute 3 (instances) or 4 (chunk layers);
+    // the disabled one must read as zero. Generic attribute values are
+    // context state, so set them once here.
+    glVertexAttrib4f(3, 0.0f, 0.0f, 0.0f, 0.0f);
+    glVertexAttrib1f(4, 0.0f);
+    // Only unit VAOs carry transforms; everything else gets identity rows
+    glVertexAttrib4f(5, 1.0f, 0.0f, 0.0f, 0.0f);
+    glVertexAttrib4f(6, 0.0f, 1.0f, 0.0f, 0.0f);
+    glVertexAttrib4f(7, 0.0f, 0.0f, 1.0f, 0.0f);
+
+    // Static chunk meshes with hidden faces removed, pre-baked if the map file has them
+    mapChunks_ = baked ? std::make_unique<MapChunks>(map_, *baked) : std::make_unique<MapChunks>(map_);
+
+    // One instance per tile, drawn with a single instanced call
+    gridRenderer_ = std::make_unique<GridRenderer>(cubeVAO_, 36);
+    gridRenderer_->build(map_);
+    gridRevision_ = map_.revision();
+
+    // Chunk/unit index for frustum culling
+    spatialGrid_ = std::make_unique<SpatialGrid>(map_);
+
+    // Tile materials packed into one array texture (layer = tile type), so a
+    // single terrain draw can mix them. Decoded off-thread, placeholder until uploaded.
+    textures_ = std::make_unique<TextureManager>();
+    std::vector<std::string> materialPaths;
+    for (const char* file : kTileMaterialPaths) {
+        materialPaths.push_back(resourcePath(file));
+    }
+    tileMaterials_ = textures_->loadArray(materialPaths, kTileMaterialSize, kTileMaterialSize);
+
+    // Fog of war mask: one texel per tile, filled by the first setFog()
+    glGenTextures(1, &fogTexture_);
+    glBindTexture(GL_TEXTURE_2D, fogTexture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, map_.width(), map_.depth(), 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+    // Linear filtering softens the fog edge across a tile
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Sphere (units) LODs in shared storage, one instance per visible unit
+    meshes_ = std::make_unique<MeshRegistry>();
+    for (int lod = 0; lod < kUnitLodCount; ++lod) {
+        unitLods_[lod] = meshes_->sphere(sphereRadius_, kUnitLodSectors[lod], kUnitLodSectors[lod]);
+    }
+
+    // GPU pass timers (double-buffered queries, read back a frame later)
+    prepassGpuTimer_ = std::make_unique<GpuTimer>("depth prepass");
+    terrainGpuTimer_ = std::make_unique<GpuTimer>("terrain");
+    sphereGpuTimer_  = std::make_unique<GpuTimer>("sphere");
+}
+
+SceneRenderer::~SceneRenderer()
+{
+    prepassGpuTimer_.reset();
+    terrainGpuTimer_.reset();
+    sphereGpuTimer_.reset();
+    gridRenderer_.reset();
+    mapChunks_.reset();
+
+    textures_.reset();
+
+    glDeleteVertexArrays(1, &cubeVAO_);
+    glDeleteBuffers(1, &cubeVBO_);
+    glDeleteBuffers(1, &cubeEBO_);
+
+    meshes_.reset();
+
+    glDeleteTextures(1, &fogTexture_);
+
+    shadows_.reset();
+    shadowShader_.reset();
+    depthShader_.reset();
+    pickShader_.reset();
+    pickBuffer_.reset();
+
+    frameUniforms_.reset();
+    stream_.reset();
+}
+
+std::unique_ptr<ShaderVariants> SceneRenderer::makeProgram(ShaderProgram program)
+{
+    std::vector<std::string> flags;
+    if (program == kProgramScene) {
+        flags = {"SOLID_COLOR", "FOG_OF_WAR", "SHADOWS"};
+    }
+    return std::make_unique<ShaderVariants>(shaderSources_[resourcePath(kProgramFiles[program][0])],
+                                            shaderSources_[resourcePath(kProgramFiles[program][1])],
+                                            std::move(flags));
+}
+
+void SceneRenderer::installProgram(ShaderProgram program, std::unique_ptr<ShaderVariants> built)
+{
+    // Resolve uniform handles once per build; draws only use these
+    switch (program) {
+    case kProgramScene:
+        shaders_ = std::move(built);
+        for (std::uint32_t variant = 0; variant < kSceneVariants; ++variant) {
+            SceneProgram& scene = programs_[variant];
+            scene.shader       = &shaders_->get(variant);
+            scene.model        = scene.shader->uniform("model");
+            scene.normalMatrix = scene.shader->uniform("normalMatrix");
+            scene.tileTextures = scene.shader->uniform("tileTextures");
+            scene.teamColors   = scene.shader->uniform("teamColors");
+            scene.fogTexture   = scene.shader->uniform("fogTexture");
+            scene.fogTransform = scene.shader->uniform("fogTransform");
+            scene.staticShadowMap    = scene.shader->uniform("staticShadowMap");
+            scene.unitShadowMap      = scene.shader->uniform("unitShadowMap");
+            scene.staticShadowMatrix = scene.shader->uniform("staticShadowMatrix");
+            scene.unitShadowMatrix   = scene.shader->uniform("unitShadowMatrix");
+            scene.shadowPcfRadius    = scene.shader->uniform("shadowPcfRadius");
+            scene.highlightRect      = scene.shader->uniform("highlightRect");
+        }
+        break;
+    case kProgramShadow:
+        // Depth only, for both shadow maps
+        shadowShader_ = built->release(0);
+        shadowLightSpace_ = shadowShader_->uniform("lightSpace");
+        shadowModel_      = shadowShader_->uniform("model");
+        // The cached terrain map was drawn with the old program
+        if (shadows_) {
+            shadows_->invalidateStatic();
+        }
+        break;
+    case kProgramDepth:
+        // Depth only, for the terrain pre-pass
+        depthShader_ = built->release(0);
+        depthModel_ = depthShader_->uniform("model");
+        break;
+    case kProgramPick:
+        pickShader_ = built->release(0);
+        pickViewProjection_ = pickShader_->uniform("viewProjection");
+        pickModel_          = pickShader_->uniform("model");
+        pickUnits_          = pickShader_->uniform("pickUnits");
+        pickTileOffset_     = pickShader_->uniform("tileOffset");
+        pickMapWidth_       = pickShader_->uniform("mapWidth");
+        break;
+    default:
+        break;
+    }
+}
+
+void SceneRenderer::watchResources(FileWatcher& watcher)
+{
+    watcher_ = &watcher;
+    // Shader text is read on the watcher thread; images decode on the
+    // texture workers, so the watcher only has to notice those
+    for (const auto& source : shaderSources_) {
+        watcher.watch(source.first, true);
+    }
+    for (const std::string& path : textures_->sourcePaths()) {
+        watcher.watch(path);
+    }
+}
+
+void SceneRenderer::applyReloads()
+{
+    if (!watcher_) {
+        return;
+    }
+
+    if (watcher_->hasChanges()) {
+        std::vector<FileChange> changes;
+        watcher_->takeChanges(changes);
+        for (FileChange& change : changes) {
+            if (textures_->reload(change.path)) {
+                spdlog::info("Reloading texture {}", change.path);
+                continue;
+            }
+            auto source = shaderSources_.find(change.path);
+            if (source == shaderSources_.end() || !change.readable) {
+                continue;
+            }
+            source->second = std::move(change.contents);
+
+            // Submit now, swap in on whichever frame the driver finishes;
+            // a newer edit replaces a rebuild still compiling
+            for (int program = 0; program < kProgramCount; ++program) {
+                if (resourcePath(kProgramFiles[program][0]) == change.path ||
+                    resourcePath(kProgramFiles[program][1]) == change.path) {
+                    shaderRebuilds_[program] = makeProgram((ShaderProgram)program);
+                    shaderRebuilds_[program]->submit(shaderCache_.get());
+                }
+            }
+        }
+    }
+
+    for (int program = 0; program < kProgramCount; ++program) {
+        std::unique_ptr<ShaderVariants>& rebuild = shaderRebuilds_[program];
+        if (!rebuild || !rebuild->ready()) {
+            continue;
+        }
+        std::unique_ptr<ShaderVariants> built = std::move(rebuild);
+        if (built->finish(shaderCache_.get())) {
+            installProgram((ShaderProgram)program, std::move(built));
+            spdlog::info("Reloaded {} + {}", kProgramFiles[program][0], kProgramFiles[program][1]);
+        } else {
+            spdlog::error("{} + {} failed to build; keeping the previous version",
+                          kProgramFiles[program][0], kProgramFiles[program][1]);
+        }
+    }
+}
+
+void SceneRenderer::createCube()
+{
+    float cubeVertices[] = {
+            // positions          // tex coords  // normals
+            // Back face
+            -0.5f, -0.5f, -0.5f,   0.f, 0.f,  0.f, 0.f, -1.f,
+            0.5f, -0.5f, -0.5f,   1.f, 0.f,  0.f, 0.f, -1.f,
+            0.5f,  0.5f, -0.5f,   1.f, 1.f,  0.f, 0.f, -1.f,
+            -0.5f,  0.5f, -0.5f,   0.f, 1.f,  0.f, 0.f, -1.f,
+
+            // Front face
+            -0.5f, -0.5f,  0.5f,   0.f, 0.f,  0.f, 0.f,  1.f,
+            0.5f, -0.5f,  0.5f,   1.f, 0.f,  0.f, 0.f,  1.f,
+            0.5f,  0.5f,  0.5f,   1.f, 1.f,  0.f, 0.f,  1.f,
+            -0.5f,  0.5f,  0.5f,   0.f, 1.f,  0.f, 0.f,  1.f,
+
+            // Left face
+            -0.5f,  0.5f,  0.5f,   1.f, 0.f, -1.f, 0.f,  0.f,
+            -0.5f,  0.5f, -0.5f,   1.f, 1.f, -1.f, 0.f,  0.f,
+            -0.5f, -0.5f, -0.5f,   0.f, 1.f, -1.f, 0.f,  0.f,
+            -0.5f, -0.5f,  0.5f,   0.f, 0.f, -1.f, 0.f,  0.f,
+
+            // Right face
+            0.5f,  0.5f,  0.5f,   1.f, 0.f,  1.f, 0.f,  0.f,
+            0.5f,  0.5f, -0.5f,   1.f, 1.f,  1.f, 0.f,  0.f,
+            0.5f, -0.5f, -0.5f,   0.f, 1.f,  1.f, 0.f,  0.f,
+            0.5f, -0.5f,  0.5f,   0.f, 0.f,  1.f, 0.f,  0.f,
+
+            // Bottom face
+            -0.5f, -0.5f, -0.5f,   0.f, 1.f,  0.f, -1.f, 0.f,
+            0.5f, -0.5f, -0.5f,   1.f, 1.f,  0.f, -1.f, 0.f,
+            0.5f, -0.5f,  0.5f,   1.f, 0.f,  0.f, -1.f, 0.f,
+            -0.5f, -0.5f,  0.5f,   0.f, 0.f,  0.f, -1.f, 0.f,
+
+            // Top face
+            -0.5f,  0.5f, -0.5f,   0.f, 1.f,  0.f,  1.f, 0.f,
+            0.5f,  0.5f, -0.5f,   1.f, 1.f,  0.f,  1.f, 0.f,
+            0.5f,  0.5f,  0.5f,   1.f, 0.f,  0.f,  1.f, 0.f,
+            -0.5f,  0.5f,  0.5f,   0.f, 0.f,  0.f,  1.f, 0.f
+    };
+    unsigned int cubeIndices[] = {
+            0,1,2, 2,3,0,
+            4,5,6, 6,7,4,
+            8,9,10,10,11,8,
+            12,13,14,14,15,12,
+            16,17,18,18,19,16,
+            20,21,22,22,23,20
+    };
+
+    glGenVertexArrays(1, &cubeVAO_);
+    glGenBuffers(1, &cubeVBO_);
+    glGenBuffers(1, &cubeEBO_);
+
+    glBindVertexArray(cubeVAO_);
+
+    // Same packed layout as the other procedural meshes
+    const int cubeVertexCount = (int)(std::size(cubeVertices) / 8);
+    MeshVertex packed[24];
+    static_assert(std::size(packed) * 8 == std::size(cubeVertices), "cube table is 24 vertices");
+    for (int k = 0; k < cubeVertexCount; ++k) {
+        const float* v = cubeVertices + k * 8;
+        packed[k] = packMeshVertex({v[0], v[1], v[2]}, {v[3], v[4]}, {v[5], v[6], v[7]});
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(packed), packed, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cubeEBO_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(cubeIndices), cubeIndices, GL_STATIC_DRAW);
+
+    meshVertexFormat().apply();
+
+    glBindVertexArray(0);
+}
+
+void SceneRenderer::execute(const RenderFrame& frame)
+{
+    PROFILE_SCOPE("render");
+    stats_ = RenderStats{};
+    frameArena_.beginFrame();
+
+    // Edited shaders and textures: nothing is drawn yet, so swapping here
+    // can't leave a frame half old, half new
+    applyReloads();
+
+    // Bring in any textures finished decoding, within a small time slice
+    textures_->pump();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // This frame's slice of the stream ring
+    stream_->beginFrame();
+
+    viewportWidth_  = frame.viewportWidth;
+    viewportHeight_ = frame.viewportHeight;
+    if (viewportWidth_ <= 0 || viewportHeight_ <= 0) {
+        GLint viewport[4] = {0, 0, 0, 0};
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        viewportWidth_  = viewport[2];
+        viewportHeight_ = viewport[3];
+    }
+
+    // Last frame's (or an earlier) pick, if the GPU has finished it
+    collectPicks();
+
+    if (map_.inBounds(frame.highlightTile.x, frame.highlightTile.y)) {
+        const glm::vec3 center = map_.tileCenter(frame.highlightTile.x, frame.highlightTile.y);
+        highlightRect_ = glm::vec4(center.x - 0.5f, center.z - 0.5f, center.x + 0.5f, center.z + 0.5f);
+    } else {
+        highlightRect_ = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+    }
+
+    if (!frame.fog.empty()) {
+        setFog(frame.fog);
+    }
+
+    for (const RenderCommand& command : frame.commands) {
+        switch (command.type) {
+            case RenderCommandType::SetView:
+                // Draws queued so far belong to the previous view
+                submitQueue();
+                setView(frame.views[command.index], frame.units);
+                buildUnitInstances(frame.units);
+                renderShadows();
+                break;
+            case RenderCommandType::DrawTerrain:
+                queueTerrain();
+                break;
+            case RenderCommandType::DrawUnits:
+                queueUnits();
+                break;
+        }
+    }
+    submitQueue();
+
+    if (frame.pickPixel.x >= 0 && frame.pickPixel.y >= 0) {
+        renderPick(frame.pickPixel, frame.frameIndex);
+    }
+
+    glBindVertexArray(0);
+    stream_->endFrame();
+
+    // Results from the previous frame, if the GPU has them yet
+    prepassGpuTimer_->collect();
+    terrainGpuTimer_->collect();
+    sphereGpuTimer_->collect();
+    stats_.frameArenaBytes = frameArena_.current().bytesUsed();
+}
+
+void SceneRenderer::setFog(const std::vector<std::uint8_t>& mask)
+{
+    if (mask.size() != (size_t)map_.width() * map_.depth()) {
+        return;
+    }
+    // One small upload for the whole board; rows of odd widths aren't 4-aligned
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, fogTexture_);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, map_.width(), map_.depth(), GL_RED, GL_UNSIGNED_BYTE, mask.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    fogEnabled_ = true;
+}
+
+void SceneRenderer::setView(const SceneView& view, const RenderUnits& units)
+{
+    // One UBO update carries camera + lighting for every draw this frame
+    FrameData frameData{};
+    frameData.view       = view.view;
+    frameData.projection = view.projection;
+    frameData.viewPos    = glm::vec4(view.viewPos, 1.0f);
+    frameData.lightPos   = glm::vec4(-lightDirection_, 0.0f);
+    frameData.lightColor = glm::vec4(lightColor_, 1.0f);
+    frameData.skyColor   = glm::vec4(skyColor_, skyStrength_);
+    frameUniforms_->update(frameData);
+    viewProjection_ = view.viewProjection;
+
+    // World units to pixels for LOD picks. Exact for the game's ortho
+    // camera (projection[1][1] = 1 / zoomLevel); a perspective view gets
+    // its focal-plane scale, which is close enough to pick a tessellation.
+    pixelsPerUnit_ = 0.5f * std::fabs(view.projection[1][1]) * (float)viewportHeight_;
+
+    // Cull chunks and units against the view frustum (ortho box or perspective)
+    PROFILE_SCOPE("cull");
+    const std::vector<glm::vec3>& positions = units.positions;
+    spatialGrid_->refreshBounds();
+    spatialGrid_->setUnits(positions, sphereRadius_);
+    if (culling_) {
+        spatialGrid_->query(view.frustum, visibleChunks_, visibleUnits_);
+    } else {
+        visibleChunks_.resize(spatialGrid_->cellCount());
+        for (int c = 0; c < (int)visibleChunks_.size(); ++c) visibleChunks_[c] = c;
+        visibleUnits_.resize(positions.size());
+        for (size_t u = 0; u < positions.size(); ++u) visibleUnits_[u] = (std::uint32_t)u;
+    }
+    stats_.visibleChunks = (int)visibleChunks_.size();
+    stats_.visibleUnits  = (int)visibleUnits_.size();
+
+    // Units just off-screen still shadow visible ground: keep every unit
+    // whose box, swept along the light down to the board's base (y = -0.5,
+    // see renderShadows), touches the view. Otherwise shadows pop in and
+    // out at the screen edge as the camera pans.
+    shadowCasters_.clear();
+    if (shadowQuality_ != ShadowQuality::Off && visibleUnits_.size() < positions.size()) {
+        std::pmr::vector<std::uint8_t> visible(positions.size(), 0, frameArena_.resource());
+        for (std::uint32_t u : visibleUnits_) {
+            visible[u] = 1;
+        }
+        const float descent = std::max(-lightDirection_.y, 0.05f);
+        for (std::uint32_t u = 0; u < (std::uint32_t)positions.size(); ++u) {
+            if (visible[u]) {
+                continue;
+            }
+            const float radius = sphereRadius_ * units.scales[u];
+            const glm::vec3 top = positions[u];
+            const glm::vec3 ground = top + lightDirection_ * ((top.y + radius + 0.5f) / descent);
+            if (view.frustum.intersectsAABB(glm::min(top, ground) - glm::vec3(radius),
+                                            glm::max(top, ground) + glm::vec3(radius))) {
+                shadowCasters_.push_back(u);
+            }
+        }
+    }
+}
+
+const SceneRenderer::SceneProgram& SceneRenderer::useProgram(std::uint32_t variant)
+{
+    if (fogEnabled_) {
+        variant |= kVariantFog;
+    }
+    if (shadowQuality_ != ShadowQuality::Off) {
+        variant |= kVariantShadows;
+    }
+    const SceneProgram& program = programs_[variant];
+    program.shader->use();
+
+    if (variant & kVariantFog) {
+        // Tile (i, j) spans world x in [i - w/2 - 0.5, i - w/2 + 0.5], likewise z
+        const float w = (float)map_.width();
+        const float d = (float)map_.depth();
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, fogTexture_);
+        program.shader->set(program.fogTexture, 1);
+        program.shader->set(program.fogTransform, glm::vec4(1.0f / w, 1.0f / d, (w / 2.0f + 0.5f) / w, (d / 2.0f + 0.5f) / d));
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    if (variant & kVariantShadows) {
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, shadows_->staticTexture());
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, shadows_->overlayTexture());
+        glActiveTexture(GL_TEXTURE0);
+        program.shader->set(program.staticShadowMap, 2);
+        program.shader->set(program.unitShadowMap, 3);
+        program.shader->set(program.staticShadowMatrix, shadows_->staticSampleMatrix());
+        program.shader->set(program.unitShadowMatrix, shadows_->overlaySampleMatrix());
+        program.shader->set(program.shadowPcfRadius, shadowPcfRadius(shadowQuality_));
+    }
+    return program;
+}
+
+void SceneRenderer::buildUnitInstances(const RenderUnits& units)
+{
+    PROFILE_SCOPE("unit instances");
+    std::fill(std::begin(unitLodCounts_), std::end(unitLodCounts_), 0);
+    unitInstanceBuffer_ = 0;
+    unitCasterCount_ = 0;
+
+    // Visible units grouped by LOD, then the shadow-only casters
+    const size_t visibleCount = visibleUnits_.size();
+    const size_t recordCount = visibleCount + shadowCasters_.size();
+    if (recordCount == 0) {
+        return;
+    }
+
+    // Pick each unit's LOD from its on-screen diameter and group the units
+    // by LOD (counting sort), so every LOD is one contiguous instanced draw
+    int lodCounts[kUnitLodCount] = {};
+    std::pmr::memory_resource* arena = frameArena_.resource();
+    std::pmr::vector<std::uint8_t> unitLod(visibleCount, arena);
+    for (size_t k = 0; k < visibleCount; ++k) {
+        const float pixels = 2.0f * sphereRadius_ * units.scales[visibleUnits_[k]] * pixelsPerUnit_;
+        int lod = 0;
+        while (lod < kUnitLodCount - 1 && pixels < kUnitLodMinPixels[lod]) {
+            ++lod;
+        }
+        unitLod[k] = (std::uint8_t)lod;
+        ++lodCounts[lod];
+    }
+    int lodStart[kUnitLodCount];
+    for (int lod = 0, start = 0; lod < kUnitLodCount; ++lod) {
+        lodStart[lod] = start;
+        start += lodCounts[lod];
+    }
+    std::pmr::vector<std::uint32_t> unitOrder(recordCount, arena);
+    {
+        int cursor[kUnitLodCount];
+        std::copy(std::begin(lodStart), std::end(lodStart), std::begin(cursor));
+        for (size_t k = 0; k < visibleCount; ++k) {
+            unitOrder[cursor[unitLod[k]]++] = visibleUnits_[k];
+        }
+        std::copy(shadowCasters_.begin(), shadowCasters_.end(), unitOrder.begin() + (std::ptrdiff_t)visibleCount);
+    }
+
+    // Gather the units into contiguous streams for the kernel
+    const std::vector<glm::vec3>& positions = units.positions;
+    std::pmr::vector<float> unitX(recordCount, arena), unitY(recordCount, arena), unitZ(recordCount, arena);
+    std::pmr::vector<float> unitScale(recordCount, arena);
+    std::pmr::vector<float> unitFacingX(recordCount, arena), unitFacingZ(recordCount, arena);
+    unitBoundsMin_ = glm::vec3(1e30f);
+    unitBoundsMax_ = glm::vec3(-1e30f);
+    for (size_t k = 0; k < recordCount; ++k) {
+        const std::uint32_t u = unitOrder[k];
+        unitX[k]       = positions[u].x;
+        unitY[k]       = positions[u].y;
+        unitZ[k]       = positions[u].z;
+        unitScale[k]   = units.scales[u];
+        unitFacingX[k] = units.facings[u].x;
+        unitFacingZ[k] = units.facings[u].y;
+        const glm::vec3 extent(sphereRadius_ * units.scales[u]);
+        unitBoundsMin_ = glm::min(unitBoundsMin_, positions[u] - extent);
+        unitBoundsMax_ = glm::max(unitBoundsMax_, positions[u] + extent);
+    }
+
+    // Build the records straight into this frame's slice of the ring; the
+    // shadow pass and the unit draw both read them
+    StreamAllocation allocation = stream_->allocate(recordCount * kUnitInstanceFloats * sizeof(float));
+    float* dst = (float*)allocation.ptr;
+    if (!dst) {
+        return;
+    }
+    TransformStreams streams;
+    streams.x       = unitX.data();
+    streams.y       = unitY.data();
+    streams.z       = unitZ.data();
+    streams.scale   = unitScale.data();
+    streams.facingX = unitFacingX.data();
+    streams.facingZ = unitFacingZ.data();
+    buildInstanceTransforms(streams, recordCount, dst, kUnitInstanceFloats);
+    for (size_t k = 0; k < recordCount; ++k) {
+        const std::uint32_t u = unitOrder[k];
+        dst[k * kUnitInstanceFloats + kTransformFloats] = (float)units.teams[u];
+        // Exact in a float up to 2^24
+        dst[k * kUnitInstanceFloats + kTransformFloats + 1] = (float)(u < units.ids.size() ? units.ids[u] : u);
+    }
+    stream_->commit(allocation);
+
+    unitInstanceBuffer_ = stream_->id();
+    unitInstanceOffset_ = allocation.offset;
+    std::copy(std::begin(lodCounts), std::end(lodCounts), std::begin(unitLodCounts_));
+    std::copy(std::begin(lodStart), std::end(lodStart), std::begin(unitLodStart_));
+    unitCasterStart_ = (int)visibleCount;
+    unitCasterCount_ = (int)shadowCasters_.size();
+}
+
+int SceneRenderer::drawUnitInstances(long long* triangles)
+{
+    if (unitInstanceBuffer_ == 0) {
+        return 0;
+    }
+    int drawCalls = 0;
+    meshes_->bind();
+    for (int lod = 0; lod < kUnitLodCount; ++lod) {
+        if (unitLodCounts_[lod] == 0) {
+            continue;
+        }
+        bindUnitInstances(unitInstanceBuffer_, unitInstanceOffset_ + (size_t)unitLodStart_[lod] * kUnitInstanceFloats * sizeof(float));
+        meshes_->drawInstanced(unitLods_[lod], unitLodCounts_[lod]);
+        drawCalls += 1;
+        if (triangles) {
+            *triangles += (long long)unitLodCounts_[lod] * (meshes_->info(unitLods_[lod]).indexCount / 3);
+        }
+    }
+    return drawCalls;
+}
+
+void SceneRenderer::renderShadows()
+{
+    if (shadowQuality_ == ShadowQuality::Off) {
+        return;
+    }
+    PROFILE_SCOPE("shadows");
+
+    // The light box covers the whole board, tallest column included
+    if (!shadowBoundsValid_ || shadowBoundsRevision_ != map_.revision()) {
+        float top = 0.0f;
+        for (float height : map_.heights()) {
+            top = std::max(top, height);
+        }
+        const float w = (float)map_.width();
+        const float d = (float)map_.depth();
+        // Room above the tallest column for the units standing on it
+        shadowBoundsMin_ = glm::vec3(-w / 2.0f - 0.5f, -0.5f, -d / 2.0f - 0.5f);
+        shadowBoundsMax_ = glm::vec3(w / 2.0f - 0.5f, top - 0.5f + 4.0f * sphereRadius_, d / 2.0f - 0.5f);
+        shadowBoundsRevision_ = map_.revision();
+        shadowBoundsValid_ = true;
+    }
+    shadows_->setLight(lightDirection_, shadowBoundsMin_, shadowBoundsMax_);
+
+    shadowShader_->use();
+
+    // Static map: every chunk, only when the light or a tile changed. Culling
+    // doesn't apply; off-screen columns still shade what's on screen.
+    if (shadows_->staticDirty(map_.revision())) {
+        PROFILE_SCOPE("static shadows");
+        mapChunks_->update();
+        shadows_->beginStatic();
+        shadowShader_->set(shadowLightSpace_, shadows_->staticMatrix());
+        const glm::mat4 dequantize = glm::scale(glm::mat4(1.0f), glm::vec3(kChunkPositionStep));
+        for (int i = 0; i < mapChunks_->chunkCount(); ++i) {
+            const ChunkMesh& mesh = mapChunks_->chunk(i);
+            if (mesh.indexCount == 0) {
+                continue;
+            }
+            shadowShader_->set(shadowModel_, glm::translate(glm::mat4(1.0f), mesh.origin) * dequantize);
+            mapChunks_->drawChunk(i);
+            stats_.drawCalls += 1;
+        }
+        shadows_->endStatic(map_.revision());
+    }
+
+    // Overlay: the units in view plus the off-screen ones shadowing it,
+    // refit around them every frame
+    if (unitInstanceBuffer_ == 0) {
+        shadows_->clearOverlay();
+        return;
+    }
+    // Receivers sample at the light-space xy of whatever shades them, so the
+    // casters' box is all the overlay has to cover
+    shadows_->beginOverlay(unitBoundsMin_, unitBoundsMax_);
+    shadowShader_->set(shadowLightSpace_, shadows_->overlayMatrix());
+    shadowShader_->set(shadowModel_, glm::mat4(1.0f));
+    stats_.drawCalls += drawUnitInstances();
+    if (unitCasterCount_ > 0) {
+        // Never seen directly, so the coarsest sphere will do
+        bindUnitInstances(unitInstanceBuffer_, unitInstanceOffset_ + (size_t)unitCasterStart_ * kUnitInstanceFloats * sizeof(float));
+        meshes_->drawInstanced(unitLods_[kUnitLodCount - 1], unitCasterCount_);
+        stats_.drawCalls += 1;
+    }
+    shadows_->endOverlay();
+}
+
+float SceneRenderer::sortDepth(const glm::vec3& worldPos) const
+{
+    // NDC depth to [0, 1]; ortho and perspective both keep it monotonic
+    const glm::vec4 clip = viewProjection_ * glm::vec4(worldPos, 1.0f);
+    return clip.w != 0.0f ? (clip.z / clip.w) * 0.5f + 0.5f : 0.0f;
+}
+
+void SceneRenderer::queueTerrain()
+{
+    PROFILE_SCOPE("terrain");
+    const std::uint32_t material = kMaterialTiles;
+    if (chunkedTerrain_) {
+        // Re-bakes only chunks whose tiles changed since last frame
+        mapChunks_->update();
+        for (int i : visibleChunks_) {
+            const ChunkMesh& mesh = mapChunks_->chunk(i);
+            if (mesh.indexCount == 0) {
+                continue;
+            }
+            const float depth = sortDepth(0.5f * (mesh.boundsMin + mesh.boundsMax));
+            if (depthPrepass_) {
+                queue_.push(RenderQueue::makeKey(RenderPass::DepthPrepass, 0, 0, kMeshChunks, depth), kDrawChunk, (std::uint32_t)i);
+            }
+            queue_.push(RenderQueue::makeKey(RenderPass::Opaque, 0, material, kMeshChunks, depth), kDrawChunk, (std::uint32_t)i);
+        }
+    } else {
+        // Instance offsets and types follow the map's edits
+        if (gridRevision_ != map_.revision()) {
+            gridRenderer_->build(map_);
+            gridRevision_ = map_.revision();
+        }
+        if (depthPrepass_) {
+            queue_.push(RenderQueue::makeKey(RenderPass::DepthPrepass, 0, 0, kMeshGrid, 0.0f), kDrawGrid, 0);
+        }
+        queue_.push(RenderQueue::makeKey(RenderPass::Opaque, 0, material, kMeshGrid, 0.0f), kDrawGrid, 0);
+    }
+}
+
+void SceneRenderer::queueUnits()
+{
+    // One item per non-empty LOD, all on the registry's VAO
+    for (int lod = 0; lod < kUnitLodCount; ++lod) {
+        if (unitInstanceBuffer_ != 0 && unitLodCounts_[lod] > 0) {
+            queue_.push(RenderQueue::makeKey(RenderPass::Opaque, kVariantSolidColor, 0, kMeshUnits, 0.0f),
+                        kDrawUnitLod, (std::uint32_t)lod);
+        }
+    }
+}
+
+void SceneRenderer::submitQueue()
+{
+    if (queue_.empty()) {
+        return;
+    }
+    {
+        PROFILE_SCOPE("queue sort");
+        queue_.sort();
+    }
+    PROFILE_SCOPE("submit");
+
+    // What's bound; only changes between runs of items trigger GL calls
+    const SceneProgram* program = nullptr;
+    RenderPass currentPass = RenderPass::Opaque;
+    std::uint32_t currentProgram = ~0u;
+    std::uint32_t currentMaterial = ~0u;
+    std::uint32_t currentMesh = ~0u;
+    bool depthTestEqual = false;
+    GpuTimer* timer = nullptr;
+
+    for (const DrawItem& item : queue_.items()) {
+        const RenderPass pass = RenderQueue::pass(item.key);
+        const std::uint32_t programId = RenderQueue::program(item.key);
+        const std::uint32_t material = RenderQueue::material(item.key);
+        const std::uint32_t mesh = RenderQueue::mesh(item.key);
+
+        // One GPU timer per run; the sort keeps each category contiguous
+        GpuTimer* itemTimer = pass == RenderPass::DepthPrepass ? prepassGpuTimer_.get()
+                            : item.kind == kDrawUnitLod ? sphereGpuTimer_.get() : terrainGpuTimer_.get();
+        if (itemTimer != timer) {
+            if (timer) timer->end();
+            timer = itemTimer;
+            timer->begin();
+        }
+
+        if (pass != currentPass || programId != currentProgram) {
+            currentPass = pass;
+            currentProgram = programId;
+            currentMaterial = ~0u;
+            currentMesh = ~0u;
+            stats_.stateChanges += 1;
+            if (pass == RenderPass::DepthPrepass) {
+                program = nullptr;
+                depthShader_->use();
+                glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            } else {
+                glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                program = &useProgram(programId);
+                program->shader->set(program->tileTextures, 0);
+                program->shader->set(program->teamColors, kTeamColors, 4);
+                // Normals are world space on every path; chunk models only
+                // translate and scale uniformly
+                program->shader->set(program->model, glm::mat4(1.0f));
+                program->shader->set(program->normalMatrix, glm::mat3(1.0f));
+                program->shader->set(program->highlightRect, highlightRect_);
+            }
+        }
+
+        if (program && material != currentMaterial) {
+            currentMaterial = material;
+            stats_.stateChanges += 1;
+            if (material == kMaterialTiles) {
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D_ARRAY, textures_->glTexture(tileMaterials_));
+            }
+        }
+
+        // Terrain the pre-pass already laid down only needs the matching
+        // fragments shaded; units weren't in it and test as usual
+        const bool wantEqual = pass == RenderPass::Opaque && depthPrepass_ && item.kind != kDrawUnitLod;
+        if (wantEqual != depthTestEqual) {
+            depthTestEqual = wantEqual;
+            glDepthFunc(wantEqual ? GL_LEQUAL : GL_LESS);
+            glDepthMask(wantEqual ? GL_FALSE : GL_TRUE);
+        }
+
+        if (mesh != currentMesh) {
+            currentMesh = mesh;
+            stats_.stateChanges += 1;
+            if (item.kind == kDrawUnitLod) {
+                meshes_->bind();
+            }
+        }
+
+        switch (item.kind) {
+            case kDrawChunk: {
+                // Positions are fixed point from the chunk origin
+                const ChunkMesh& chunk = mapChunks_->chunk((int)item.index);
+                const glm::mat4 model = glm::translate(glm::mat4(1.0f), chunk.origin) *
+                                        glm::scale(glm::mat4(1.0f), glm::vec3(kChunkPositionStep));
+                if (program) {
+                    program->shader->set(program->model, model);
+                } else {
+                    depthShader_->set(depthModel_, model);
+                }
+                mapChunks_->drawChunk((int)item.index);
+                stats_.drawCalls += 1;
+                if (pass == RenderPass::Opaque) {
+                    stats_.triangles += chunk.indexCount / 3;
+                }
+                break;
+            }
+            case kDrawGrid: {
+                // Tile cube instances are offset in the shader
+                if (program) {
+                    program->shader->set(program->model, glm::mat4(1.0f));
+                } else {
+                    depthShader_->set(depthModel_, glm::mat4(1.0f));
+                }
+                long long instances = 0;
+                stats_.drawCalls += gridRenderer_->draw(visibleChunks_, &instances);
+                if (pass == RenderPass::Opaque) {
+                    stats_.triangles += instances * gridRenderer_->indexCount() / 3;
+                }
+                break;
+            }
+            case kDrawUnitLod: {
+                const int lod = (int)item.index;
+                bindUnitInstances(unitInstanceBuffer_, unitInstanceOffset_ + (size_t)unitLodStart_[lod] * kUnitInstanceFloats * sizeof(float));
+                meshes_->drawInstanced(unitLods_[lod], unitLodCounts_[lod]);
+                stats_.drawCalls += 1;
+                stats_.triangles += (long long)unitLodCounts_[lod] * (meshes_->info(unitLods_[lod]).indexCount / 3);
+                break;
+            }
+        }
+    }
+    if (timer) {
+        timer->end();
+    }
+
+    // Leave the defaults for whatever draws next
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    if (depthTestEqual) {
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+    }
+    queue_.clear();
+}
+
+void SceneRenderer::renderPick(const glm::ivec2& pixel, std::uint64_t frameIndex)
+{
+    PROFILE_SCOPE("pick");
+
+    // Render just the pixel under the cursor, and only what's in its frustum
+    const glm::vec2 viewport((float)viewportWidth_, (float)viewportHeight_);
+    const glm::mat4 pickViewProjection =
+            pickRegionMatrix(glm::vec2(pixel.x + 0.5f, pixel.y + 0.5f), 1.0f, viewport) * viewProjection_;
+    spatialGrid_->query(Frustum(pickViewProjection), pickChunks_, pickUnitIndices_);
+
+    pickBuffer_->begin();
+    pickShader_->use();
+    pickShader_->set(pickViewProjection_, pickViewProjection);
+    pickShader_->set(pickUnits_, 0);
+    pickShader_->set(pickTileOffset_, glm::vec2(map_.width() / 2.0f + 0.5f, map_.depth() / 2.0f + 0.5f));
+    pickShader_->set(pickMapWidth_, map_.width());
+
+    if (chunkedTerrain_) {
+        const glm::mat4 dequantize = glm::scale(glm::mat4(1.0f), glm::vec3(kChunkPositionStep));
+        for (int i : pickChunks_) {
+            const ChunkMesh& mesh = mapChunks_->chunk(i);
+            if (mesh.indexCount == 0) {
+                continue;
+            }
+            pickShader_->set(pickModel_, glm::translate(glm::mat4(1.0f), mesh.origin) * dequantize);
+            mapChunks_->drawChunk(i);
+            stats_.drawCalls += 1;
+        }
+    } else {
+        pickShader_->set(pickModel_, glm::mat4(1.0f));
+        stats_.drawCalls += gridRenderer_->draw(pickChunks_, nullptr);
+    }
+
+    // The instance records are already built; all visible units go in
+    if (!pickUnitIndices_.empty()) {
+        pickShader_->set(pickUnits_, 1);
+        pickShader_->set(pickModel_, glm::mat4(1.0f));
+        stats_.drawCalls += drawUnitInstances();
+    }
+
+    pickBuffer_->end(frameIndex);
+}
+
+bool SceneRenderer::pickPending() const
+{
+    return pickBuffer_->pending();
+}
+
+void SceneRenderer::collectPicks()
+{
+    std::uint32_t id = 0;
+    std::uint64_t frameIndex = 0;
+    while (pickBuffer_->poll(id, frameIndex)) {
+        PickResult result;
+        result.frameIndex = frameIndex;
+        if (id & kPickUnitBit) {
+            result.kind = PickKind::Unit;
+            result.unitId = id & ~kPickUnitBit;
+        } else if (id & kPickTileBit) {
+            const std::uint32_t index = id & ~kPickTileBit;
+            result.kind = PickKind::Tile;
+            result.tile = glm::ivec2((int)(index % (std::uint32_t)map_.width()), (int)(index / (std::uint32_t)map_.width()));
+        }
+        pick_ = result;
+        pickReady_ = true;
+    }
+}
+
+bool SceneRenderer::hasPendingWork() const
+{
+    if (textures_->pendingCount() > 0) {
+        return true;
+    }
+    for (const std::unique_ptr<ShaderVariants>& rebuild : shaderRebuilds_) {
+        if (rebuild) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SceneRenderer::takePick(PickResult& result)
+{
+    if (!pickReady_) {
+        return false;
+    }
+    result = pick_;
+    pickReady_ = false;
+    return true;
+}
@@ -0,0 +1,274 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_SCENERENDERER_H
+#define TACTICGAME_SCENERENDERER_H
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "FrameArena.h"
+#include "FrameUniforms.h"
+#include "GridRenderer.h"
+#include "MapChunks.h"
+#include "MeshRegistry.h"
+#include "Picking.h"
+#include "Profiler.h"
+#include "RenderCommands.h"
+#include "RenderQueue.h"
+#include "Shader.h"
+#include "ShaderVariants.h"
+#include "ShadowMaps.h"
+#include "StreamBuffer.h"
+#include "SpatialGrid.h"
+#include "TextureManager.h"
+
+class FileWatcher;
+class MapFile;
+class PickBuffer;
+class ShaderCache;
+class TileMap;
+
+// What the last execute() submitted
+struct RenderStats
+{
+    int drawCalls = 0;
+    long long triangles = 0;
+    int visibleChunks = 0;
+    int visibleUnits = 0;
+    int stateChanges = 0; // program, material and mesh switches in the queue
+    std::size_t frameArenaBytes = 0; // transient allocations this frame
+};
+
+// Owns the GL resources for the board + unit spheres and draws them.
+// Shared by the game and the benchmark so both exercise the same path.
+// Needs a current GL context for its whole lifetime.
+class SceneRenderer
+{
+public:
+    // `baked`, if given, supplies pre-baked chunk meshes for the unedited `map`;
+    // it is only read during construction
+    explicit SceneRenderer(const TileMap& map, const MapFile* baked = nullptr);
+    ~SceneRenderer();
+
+    SceneRenderer(const SceneRenderer&) = delete;
+    SceneRenderer& operator=(const SceneRenderer&) = delete;
+
+    // Baked chunk meshes (default) or one instanced cube per tile
+    void setChunkedTerrain(bool enabled) { chunkedTerrain_ = enabled; }
+    bool chunkedTerrain() const { return chunkedTerrain_; }
+
+    // Directional shadows and their filtering (3x3 PCF by default)
+    void setShadowQuality(ShadowQuality quality) { shadowQuality_ = quality; }
+    ShadowQuality shadowQuality() const { return shadowQuality_; }
+    // Times the cached terrain shadow map has been rendered
+    int staticShadowRenders() const { return shadows_->staticRenders(); }
+
+    // Depth-only terrain pass before shading, so the lit fragment shader
+    // runs once per covered pixel (off by default)
+    void setDepthPrepass(bool enabled) { depthPrepass_ = enabled; }
+    bool depthPrepass() const { return depthPrepass_; }
+
+    // Latest finished GPU pick (RenderFrame::pickPixel), once each; picks
+    // arrive a frame or more after the frame that asked for them
+    bool takePick(PickResult& result);
+    // Pick readbacks the GPU hasn't finished yet. They don't need another
+    // frame drawn: collectPicks() gathers them between frames.
+    bool pickPending() const;
+    // Moves finished readbacks to takePick(); execute() does this too
+    void collectPicks();
+
+    // Work that needs more frames to finish: textures still streaming in,
+    // shader rebuilds
+    bool hasPendingWork() const;
+
+    // Hot reload: registers the shader and texture files with `watcher`,
+    // which must outlive the renderer. Changes are picked up at the start of
+    // a frame; rebuilt programs and textures replace the old ones only once
+    // complete, so no frame waits on them, and an edit that fails to build
+    // keeps the last good version.
+    void watchResources(FileWatcher& watcher);
+
+    // Frustum culling of chunks and units (on by default)
+    void setCulling(bool enabled) { culling_ = enabled; }
+    bool culling() const { return culling_; }
+
+    // Clears the bound framebuffer and runs the frame's command list: terrain
+    // plus one sphere per unit, all visible spheres in one instanced draw
+    void execute(const RenderFrame& frame);
+
+    // Unit sphere radius; simulation code places units with it before any
+    // renderer (or GL context) exists
+    static constexpr float kUnitRadius = 0.3f;
+    // Unit sphere tessellations, picked per unit by on-screen size
+    static constexpr int kUnitLodCount = 4;
+    float sphereRadius() const { return sphereRadius_; }
+    TextureManager& textures() { return *textures_; }
+    const RenderStats& stats() const { return stats_; }
+
+private:
+    const TileMap& map_;
+
+    // Light (directional; the way it travels), sky
+    glm::vec3 lightDirection_;
+    glm::vec3 lightColor_;
+    glm::vec3 skyColor_;
+    float skyStrength_;
+
+    std::unique_ptr<StreamBuffer> stream_;
+    std::unique_ptr<FrameUniformBuffer> frameUniforms_;
+
+    // Main shader variants, indexed by these bits (ShaderVariants flag order)
+    static constexpr std::uint32_t kVariantSolidColor = 1;
+    static constexpr std::uint32_t kVariantFog = 2;
+    static constexpr std::uint32_t kVariantShadows = 4;
+    static constexpr std::uint32_t kSceneVariants = 8;
+    struct SceneProgram
+    {
+        Shader* shader = nullptr;
+        Shader::Uniform model;
+        Shader::Uniform normalMatrix;
+        Shader::Uniform tileTextures;
+        Shader::Uniform teamColors;
+        Shader::Uniform fogTexture;
+        Shader::Uniform fogTransform;
+        Shader::Uniform staticShadowMap;
+        Shader::Uniform unitShadowMap;
+        Shader::Uniform staticShadowMatrix;
+        Shader::Uniform unitShadowMatrix;
+        Shader::Uniform shadowPcfRadius;
+        Shader::Uniform highlightRect;
+    };
+    std::unique_ptr<ShaderVariants> shaders_;
+    SceneProgram programs_[kSceneVariants];
+
+    // Every program, by its kProgramFiles entry. Singles are one-variant
+    // ShaderVariants too, so all of them build and rebuild the same way.
+    enum ShaderProgram { kProgramScene, kProgramShadow, kProgramDepth, kProgramPick, kProgramCount };
+    std::unique_ptr<ShaderCache> shaderCache_;
+    std::unordered_map<std::string, std::string> shaderSources_; // file path -> text
+    FileWatcher* watcher_;
+    std::unique_ptr<ShaderVariants> shaderRebuilds_[kProgramCount]; // submitted, not yet swapped in
+
+    unsigned int cubeVAO_, cubeVBO_, cubeEBO_;
+    std::unique_ptr<MeshRegistry> meshes_;
+    MeshHandle unitLods_[kUnitLodCount];
+    float sphereRadius_;
+    int viewportHeight_;
+    float pixelsPerUnit_; // at the current view, for LOD picks
+    std::unique_ptr<TextureManager> textures_;
+    TextureHandle tileMaterials_;
+
+    std::unique_ptr<MapChunks> mapChunks_;
+    std::unique_ptr<GridRenderer> gridRenderer_;
+    bool chunkedTerrain_;
+    std::uint32_t gridRevision_; // map revision the tile instances were built from
+
+    // Fog of war; off until the first mask arrives
+    unsigned int fogTexture_;
+    bool fogEnabled_;
+
+    // Draw queue, sorted and submitted at the end of each view
+    RenderQueue queue_;
+    static constexpr std::uint32_t kDrawChunk = 0;   // index = chunk
+    static constexpr std::uint32_t kDrawGrid = 1;    // the instanced tile cubes
+    static constexpr std::uint32_t kDrawUnitLod = 2; // index = unit LOD
+    static constexpr std::uint32_t kMaterialTiles = 1;
+    // Queue mesh ids. Chunks share one: drawChunk() binds each chunk's own
+    // VAO, so keying by VAO would only sort them by name ahead of depth.
+    static constexpr std::uint32_t kMeshChunks = 0;
+    static constexpr std::uint32_t kMeshGrid = 1;
+    static constexpr std::uint32_t kMeshUnits = 2;
+    glm::mat4 viewProjection_{1.0f};
+    std::unique_ptr<Shader> depthShader_;
+    Shader::Uniform depthModel_;
+    bool depthPrepass_;
+    int viewportWidth_;
+    glm::vec4 highlightRect_; // RenderFrame::highlightTile's footprint
+
+    // GPU picking: ID pass into one pixel, asynchronous readback
+    std::unique_ptr<PickBuffer> pickBuffer_;
+    std::unique_ptr<Shader> pickShader_;
+    Shader::Uniform pickViewProjection_;
+    Shader::Uniform pickModel_;
+    Shader::Uniform pickUnits_;
+    Shader::Uniform pickTileOffset_;
+    Shader::Uniform pickMapWidth_;
+    std::vector<int> pickChunks_;
+    std::vector<std::uint32_t> pickUnitIndices_;
+    PickResult pick_;
+    bool pickReady_;
+
+    // Shadows: cached terrain map + per-frame unit overlay
+    std::unique_ptr<ShadowMaps> shadows_;
+    std::unique_ptr<Shader> shadowShader_;
+    Shader::Uniform shadowLightSpace_;
+    Shader::Uniform shadowModel_;
+    ShadowQuality shadowQuality_;
+    bool shadowBoundsValid_;
+    std::uint32_t shadowBoundsRevision_; // map revision the light box was fitted to
+    glm::vec3 shadowBoundsMin_{0.0f};
+    glm::vec3 shadowBoundsMax_{0.0f};
+
+    std::unique_ptr<SpatialGrid> spatialGrid_;
+    bool culling_;
+    std::vector<int> visibleChunks_;
+    std::vector<std::uint32_t> visibleUnits_;
+    // Off-screen units whose shadows can still reach the view
+    std::vector<std::uint32_t> shadowCasters_;
+    // This frame's unit instance records (buffer 0 = none) and the bounds
+    // of everything that casts into the shadow overlay
+    unsigned int unitInstanceBuffer_;
+    std::size_t unitInstanceOffset_;
+    int unitLodCounts_[kUnitLodCount];
+    int unitLodStart_[kUnitLodCount];
+    int unitCasterStart_; // shadowCasters_' records, after the visible ones
+    int unitCasterCount_;
+    glm::vec3 unitBoundsMin_{0.0f};
+    glm::vec3 unitBoundsMax_{0.0f};
+
+    std::unique_ptr<GpuTimer> prepassGpuTimer_;
+    std::unique_ptr<GpuTimer> terrainGpuTimer_;
+    std::unique_ptr<GpuTimer> sphereGpuTimer_;
+
+    // Transient per-frame lists (LOD grouping, kernel input streams)
+    FrameArena frameArena_;
+
+    RenderStats stats_;
+
+    void createCube();
+    // Variants of `program` from the current shaderSources_, not yet built
+    std::unique_ptr<ShaderVariants> makeProgram(ShaderProgram program);
+    // Swaps a built `program` in and re-resolves its uniform handles
+    void installProgram(ShaderProgram program, std::unique_ptr<ShaderVariants> built);
+    // Frame start: takes the watcher's changes, swaps in finished rebuilds
+    void applyReloads();
+    void setFog(const std::vector<std::uint8_t>& mask);
+    // Binds the variant (plus fog, once a mask has arrived) and its fog inputs
+    const SceneProgram& useProgram(std::uint32_t variant);
+    void setView(const SceneView& view, const RenderUnits& units);
+    // Sorts the visible units by LOD and writes their instance records
+    void buildUnitInstances(const RenderUnits& units);
+    // One draw per non-empty LOD with whatever program is bound; returns the draw count
+    int drawUnitInstances(long long* triangles = nullptr);
+    // Refreshes the static shadow map if stale and redraws the unit overlay
+    void renderShadows();
+    // Sort depth of a world position in the current view, [0, 1]
+    float sortDepth(const glm::vec3& worldPos) const;
+    // Queue the visible terrain (both passes) and the unit LOD batches
+    void queueTerrain();
+    void queueUnits();
+    // Sorts the queue and draws it, binding state only where it changes
+    void submitQueue();
+    // ID pass for one pixel (GL window coordinates) of the current view
+    void renderPick(const glm::ivec2& pixel, std::uint64_t frameIndex);
+};
+
+
+#endif //TACTICGAME_SCENERENDERER_H
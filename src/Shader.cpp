@@ -3,19 +3,46 @@
 //
 
 #include "Shader.h"
+#include "FrameUniforms.h"
 #include <iostream>
+#include <vector>
 
 Shader::Shader(const std::string& vertexCode, const std::string& fragmentCode)
 {
     // Compile
-    unsigned int vs = compileShader(vertexCode.c_str(), GL_VERTEX_SHADER);
-    unsigned int fs = compileShader(fragmentCode.c_str(), GL_FRAGMENT_SHADER);
+    unsigned int vs = submitStage(vertexCode.c_str(), GL_VERTEX_SHADER);
+    unsigned int fs = submitStage(fragmentCode.c_str(), GL_FRAGMENT_SHADER);
+    stageCompiled(vs);
+    stageCompiled(fs);
 
     // Link
-    linkProgram(vs, fs);
+    program_ = glCreateProgram();
+    glAttachShader(program_, vs);
+    glAttachShader(program_, fs);
+    glLinkProgram(program_);
+    programLinked(program_);
 
     glDeleteShader(vs);
     glDeleteShader(fs);
+
+    finishProgram();
+}
+
+Shader::Shader(unsigned int program)
+        : program_(program)
+{
+    finishProgram();
+}
+
+void Shader::finishProgram()
+{
+    cacheUniforms();
+
+    // Hook up the shared per-frame block if this program uses it
+    unsigned int frameBlock = glGetUniformBlockIndex(program_, kFrameUniformBlockName);
+    if (frameBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program_, frameBlock, kFrameUniformBinding);
+    }
 }
 
 Shader::~Shader()
@@ -28,37 +55,95 @@ void Shader::use() const
     glUseProgram(program_);
 }
 
+Shader::Uniform Shader::uniform(const std::string &name) const
+{
+    auto it = uniforms_.find(name);
+    if (it == uniforms_.end()) {
+        return {};
+    }
+    return {it->second};
+}
+
+void Shader::set(Uniform u, bool value) const
+{
+    glUniform1i(u.location, (int)value);
+}
+
+void Shader::set(Uniform u, int value) const
+{
+    glUniform1i(u.location, value);
+}
+
+void Shader::set(Uniform u, float value) const
+{
+    glUniform1f(u.location, value);
+}
+
+void Shader::set(Uniform u, const glm::vec2 &value) const
+{
+    glUniform2fv(u.location, 1, &value[0]);
+}
+
+void Shader::set(Uniform u, const glm::vec3 &value) const
+{
+    glUniform3fv(u.location, 1, &value[0]);
+}
+
+void Shader::set(Uniform u, const glm::vec3 *values, int count) const
+{
+    glUniform3fv(u.location, count, &values[0][0]);
+}
+
+void Shader::set(Uniform u, const glm::vec4 &value) const
+{
+    glUniform4fv(u.location, 1, &value[0]);
+}
+
+void Shader::set(Uniform u, const glm::mat3 &mat) const
+{
+    glUniformMatrix3fv(u.location, 1, GL_FALSE, &mat[0][0]);
+}
+
+void Shader::set(Uniform u, const glm::mat4 &mat) const
+{
+    glUniformMatrix4fv(u.location, 1, GL_FALSE, &mat[0][0]);
+}
+
 void Shader::setBool(const std::string &name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(program_, name.c_str()), (int)value);
+    set(uniform(name), value);
 }
 
 void Shader::setInt(const std::string &name, int value) const
 {
-    glUniform1i(glGetUniformLocation(program_, name.c_str()), value);
+    set(uniform(name), value);
 }
 
 void Shader::setFloat(const std::string &name, float value) const
 {
-    glUniform1f(glGetUniformLocation(program_, name.c_str()), value);
+    set(uniform(name), value);
 }
 
 void Shader::setVec3(const std::string &name, const glm::vec3 &value) const
 {
-    glUniform3fv(glGetUniformLocation(program_, name.c_str()), 1, &value[0]);
+    set(uniform(name), value);
 }
 
 void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(program_, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    set(uniform(name), mat);
 }
 
-unsigned int Shader::compileShader(const char* source, GLenum type)
+unsigned int Shader::submitStage(const char* source, GLenum type)
 {
     unsigned int shader = glCreateShader(type);
     glShaderSource(shader, 1, &source, nullptr);
     glCompileShader(shader);
+    return shader;
+}
 
+bool Shader::stageCompiled(unsigned int shader)
+{
     int success;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
     if(!success)
@@ -67,22 +152,50 @@ unsigned int Shader::compileShader(const char* source, GLenum type)
         glGetShaderInfoLog(shader, 512, nullptr, infoLog);
         std::cerr << "ERROR: Shader compilation failed: " << infoLog << std::endl;
     }
-    return shader;
+    return success != 0;
 }
 
-void Shader::linkProgram(unsigned int vs, unsigned int fs)
+bool Shader::programLinked(unsigned int program)
 {
-    program_ = glCreateProgram();
-    glAttachShader(program_, vs);
-    glAttachShader(program_, fs);
-    glLinkProgram(program_);
-
     int success;
-    glGetProgramiv(program_, GL_LINK_STATUS, &success);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
     if(!success)
     {
         char infoLog[512];
-        glGetProgramInfoLog(program_, 512, nullptr, infoLog);
+        glGetProgramInfoLog(program, 512, nullptr, infoLog);
         std::cerr << "ERROR: Shader linking failed: " << infoLog << std::endl;
     }
-}
\ No newline at end of file
+    return success != 0;
+}
+
+void Shader::cacheUniforms()
+{
+    uniforms_.clear();
+
+    int count = 0;
+    int maxLength = 0;
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> nameBuffer(maxLength > 0 ? maxLength : 1);
+    for (int i = 0; i < count; ++i)
+    {
+        int length = 0;
+        int size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program_, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+
+        std::string name(nameBuffer.data(), length);
+        int location = glGetUniformLocation(program_, name.c_str());
+        if (location < 0) {
+            continue; // lives in a uniform block
+        }
+        uniforms_[name] = location;
+
+        // Arrays are reported as "name[0]"; also allow the bare name
+        auto bracket = name.find('[');
+        if (bracket != std::string::npos) {
+            uniforms_[name.substr(0, bracket)] = location;
+        }
+    }
+}
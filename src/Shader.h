@@ -7,29 +7,68 @@
 
 
 #include <string>
+#include <unordered_map>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
 class Shader
 {
 public:
+    // Handle to a resolved uniform location. Fetch it once with uniform()
+    // and reuse it every frame; an invalid handle makes set() a no-op.
+    struct Uniform
+    {
+        int location = -1;
+        bool valid() const { return location >= 0; }
+    };
+
     Shader(const std::string& vertexCode, const std::string& fragmentCode);
+    // Adopts an already linked program (see ShaderVariants)
+    explicit Shader(unsigned int program);
     ~Shader();
 
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
     void use() const;
+    unsigned int id() const { return program_; }
+
+    // Look up a uniform in the cache built after link (no GL call)
+    Uniform uniform(const std::string &name) const;
 
-    // Set uniform helpers
+    // Typed setters for cached handles
+    void set(Uniform u, bool value) const;
+    void set(Uniform u, int value) const;
+    void set(Uniform u, float value) const;
+    void set(Uniform u, const glm::vec2 &value) const;
+    void set(Uniform u, const glm::vec3 &value) const;
+    void set(Uniform u, const glm::vec3 *values, int count) const;
+    void set(Uniform u, const glm::vec4 &value) const;
+    void set(Uniform u, const glm::mat3 &mat) const;
+    void set(Uniform u, const glm::mat4 &mat) const;
+
+    // Set uniform helpers (by name, resolved through the cache)
     void setBool(const std::string &name, bool value) const;
     void setInt(const std::string &name, int value) const;
     void setFloat(const std::string &name, float value) const;
     void setVec3(const std::string &name, const glm::vec3 &value) const;
     void setMat4(const std::string &name, const glm::mat4 &mat) const;
 
+    // Build steps, split so many programs can be in flight at once: drivers
+    // may compile and link in the background until a status is queried
+    static unsigned int submitStage(const char* source, GLenum type);
+    // Both log the info log on failure
+    static bool stageCompiled(unsigned int shader);
+    static bool programLinked(unsigned int program);
+
 private:
     unsigned int program_;
 
-    unsigned int compileShader(const char* source, GLenum type);
-    void linkProgram(unsigned int vs, unsigned int fs);
+    // Active uniform name -> location, filled once after link
+    std::unordered_map<std::string, int> uniforms_;
+
+    void finishProgram();
+    void cacheUniforms();
 };
 
 
@@ -0,0 +1,167 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "ShaderCache.h"
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// FNV-1a, continued from `hash`
+std::uint64_t hashBytes(const void* data, size_t size, std::uint64_t hash = 14695981039346656037ull)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t hashString(const char* text, std::uint64_t hash)
+{
+    // Keep the terminator so "ab"+"c" and "a"+"bc" differ
+    return text ? hashBytes(text, std::strlen(text) + 1, hash) : hashBytes("", 1, hash);
+}
+
+struct CacheEntryHeader
+{
+    char magic[4];
+    std::uint32_t format;
+    std::uint64_t key;
+    std::uint32_t length;
+    std::uint32_t reserved;
+};
+
+constexpr char kCacheMagic[4] = {'T', 'G', 'S', 'C'};
+
+} // namespace
+
+ShaderCache::ShaderCache(std::string directory)
+        : directory_(std::move(directory)),
+          driverHash_(0),
+          enabled_(false),
+          hits_(0),
+          misses_(0)
+{
+#if defined(GL_VERSION_4_1)
+    if (GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary) {
+        int formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        enabled_ = formats > 0;
+    }
+#endif
+    if (!enabled_) {
+        spdlog::info("ShaderCache: program binaries unsupported, compiling from source");
+        return;
+    }
+
+    std::uint64_t hash = hashString((const char*)glGetString(GL_VENDOR), 14695981039346656037ull);
+    hash = hashString((const char*)glGetString(GL_RENDERER), hash);
+    driverHash_ = hashString((const char*)glGetString(GL_VERSION), hash);
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) {
+        spdlog::warn("ShaderCache: cannot create {} ({}), caching disabled", directory_, error.message());
+        enabled_ = false;
+    }
+}
+
+std::uint64_t ShaderCache::key(const std::string& vertexSource, const std::string& fragmentSource) const
+{
+    std::uint64_t hash = hashString(vertexSource.c_str(), driverHash_);
+    return hashString(fragmentSource.c_str(), hash);
+}
+
+std::string ShaderCache::pathFor(std::uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+bool ShaderCache::load(std::uint64_t key, unsigned int program)
+{
+#if defined(GL_VERSION_4_1)
+    if (enabled_) {
+        std::ifstream in(pathFor(key), std::ios::binary);
+        CacheEntryHeader header{};
+        if (in.read(reinterpret_cast<char*>(&header), sizeof(header))
+            && std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) == 0
+            && header.key == key) {
+            std::vector<char> binary(header.length);
+            if (in.read(binary.data(), (std::streamsize)binary.size())) {
+                glProgramBinary(program, (GLenum)header.format, binary.data(), (GLsizei)binary.size());
+                int linked = 0;
+                glGetProgramiv(program, GL_LINK_STATUS, &linked);
+                if (linked) {
+                    ++hits_;
+                    return true;
+                }
+                // Usually a driver update the version string didn't reflect
+                spdlog::info("ShaderCache: driver rejected {:016x}, recompiling", key);
+            }
+        }
+    }
+#endif
+    ++misses_;
+    return false;
+}
+
+void ShaderCache::prepare(unsigned int program) const
+{
+#if defined(GL_VERSION_4_1)
+    if (enabled_) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+#endif
+}
+
+void ShaderCache::store(std::uint64_t key, unsigned int program) const
+{
+#if defined(GL_VERSION_4_1)
+    if (!enabled_) {
+        return;
+    }
+    int length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    std::vector<char> binary((size_t)length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    CacheEntryHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.format = format;
+    header.key    = key;
+    header.length = (std::uint32_t)length;
+
+    // Write then rename, so a crash never leaves a half-written entry
+    const std::string path = pathFor(key);
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), length);
+        if (!out) {
+            spdlog::warn("ShaderCache: cannot write {}", temp);
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temp, path, error);
+    if (error) {
+        spdlog::warn("ShaderCache: cannot write {} ({})", path, error.message());
+    }
+#endif
+}
@@ -0,0 +1,49 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_SHADERCACHE_H
+#define TACTICGAME_SHADERCACHE_H
+
+
+#include <cstdint>
+#include <string>
+
+// On-disk cache of linked program binaries (GL 4.1 / ARB_get_program_binary).
+// Entries are keyed by a hash of the program's final sources plus the
+// driver's vendor, renderer and version strings, so a source edit or a
+// driver update simply misses. A binary the driver rejects counts as a miss
+// and is overwritten by the fresh compile.
+//
+// Needs a current context; without binary support every call misses.
+class ShaderCache
+{
+public:
+    explicit ShaderCache(std::string directory = "shader_cache");
+
+    bool enabled() const { return enabled_; }
+
+    std::uint64_t key(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    // Loads the cached binary into `program`; false if missing or rejected
+    bool load(std::uint64_t key, unsigned int program);
+    // Call before glLinkProgram so the binary stays retrievable
+    void prepare(unsigned int program) const;
+    // Saves the linked program's binary
+    void store(std::uint64_t key, unsigned int program) const;
+
+    int hits() const { return hits_; }
+    int misses() const { return misses_; }
+
+private:
+    std::string directory_;
+    std::uint64_t driverHash_;
+    bool enabled_;
+    int hits_;
+    int misses_;
+
+    std::string pathFor(std::uint64_t key) const;
+};
+
+
+#endif //TACTICGAME_SHADERCACHE_H
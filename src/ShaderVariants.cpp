@@ -0,0 +1,150 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "ShaderVariants.h"
+#include "ShaderCache.h"
+#include "Profiler.h"
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+ShaderVariants::ShaderVariants(std::string vertexSource, std::string fragmentSource, std::vector<std::string> flags)
+        : vertexSource_(std::move(vertexSource)),
+          fragmentSource_(std::move(fragmentSource)),
+          flags_(std::move(flags))
+{
+}
+
+ShaderVariants::~ShaderVariants()
+{
+    // A rebuild dropped before it was collected
+    for (const Pending& job : pending_) {
+        glDeleteShader(job.vs);
+        glDeleteShader(job.fs);
+        glDeleteProgram(job.program);
+    }
+}
+
+std::string ShaderVariants::withDefines(const std::string& source, const std::vector<std::string>& defines)
+{
+    if (defines.empty()) {
+        return source;
+    }
+
+    // #version has to stay the first directive
+    size_t insertAt = 0;
+    size_t version = source.find("#version");
+    if (version != std::string::npos) {
+        size_t end = source.find('\n', version);
+        insertAt = end == std::string::npos ? source.size() : end + 1;
+    }
+    // Lines before the insert point, so #line keeps compiler errors pointing
+    // at the original source
+    int line = 1;
+    for (size_t i = 0; i < insertAt; ++i) {
+        line += source[i] == '\n';
+    }
+
+    std::string block;
+    for (const std::string& define : defines) {
+        block += "#define " + define + "\n";
+    }
+    block += "#line " + std::to_string(line) + "\n";
+
+    std::string result = source;
+    result.insert(insertAt, block);
+    return result;
+}
+
+void ShaderVariants::build(ShaderCache* cache)
+{
+    PROFILE_SCOPE("ShaderVariants::build");
+    submit(cache);
+    finish(cache);
+}
+
+void ShaderVariants::submit(ShaderCache* cache)
+{
+#if defined(GL_KHR_parallel_shader_compile)
+    if (GLAD_GL_KHR_parallel_shader_compile) {
+        // Let the driver pick how many threads to use
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    }
+#endif
+
+    shaders_.clear();
+    shaders_.resize((size_t)count());
+    for (std::uint32_t mask = 0; mask < (std::uint32_t)count(); ++mask) {
+        std::vector<std::string> defines;
+        for (size_t k = 0; k < flags_.size(); ++k) {
+            if (mask & (1u << k)) {
+                defines.push_back(flags_[k]);
+            }
+        }
+        const std::string vertex = withDefines(vertexSource_, defines);
+        const std::string fragment = withDefines(fragmentSource_, defines);
+
+        Pending job{mask, 0, glCreateProgram(), 0, 0};
+        if (cache) {
+            job.key = cache->key(vertex, fragment);
+            if (cache->load(job.key, job.program)) {
+                shaders_[mask] = std::make_unique<Shader>(job.program);
+                continue;
+            }
+        }
+
+        // Queue the compile and link; no status queries yet
+        job.vs = Shader::submitStage(vertex.c_str(), GL_VERTEX_SHADER);
+        job.fs = Shader::submitStage(fragment.c_str(), GL_FRAGMENT_SHADER);
+        glAttachShader(job.program, job.vs);
+        glAttachShader(job.program, job.fs);
+        if (cache) {
+            cache->prepare(job.program);
+        }
+        glLinkProgram(job.program);
+        pending_.push_back(job);
+    }
+}
+
+bool ShaderVariants::ready() const
+{
+#if defined(GL_KHR_parallel_shader_compile)
+    if (GLAD_GL_KHR_parallel_shader_compile) {
+        for (const Pending& job : pending_) {
+            int done = GL_FALSE;
+            glGetProgramiv(job.program, GL_COMPLETION_STATUS_KHR, &done);
+            if (!done) {
+                return false;
+            }
+        }
+    }
+#endif
+    return true;
+}
+
+bool ShaderVariants::finish(ShaderCache* cache)
+{
+    // Collect the results, blocking on each in turn
+    bool ok = true;
+    const size_t compiled = pending_.size();
+    for (const Pending& job : pending_) {
+        Shader::stageCompiled(job.vs);
+        Shader::stageCompiled(job.fs);
+        const bool linked = Shader::programLinked(job.program);
+        glDetachShader(job.program, job.vs);
+        glDetachShader(job.program, job.fs);
+        glDeleteShader(job.vs);
+        glDeleteShader(job.fs);
+        if (linked && cache) {
+            cache->store(job.key, job.program);
+        }
+        ok = ok && linked;
+        shaders_[job.mask] = std::make_unique<Shader>(job.program);
+    }
+    pending_.clear();
+
+    spdlog::info("ShaderVariants: {} variants, {} from cache, {} compiled",
+                 count(), count() - (int)compiled, compiled);
+    return ok;
+}
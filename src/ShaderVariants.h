@@ -0,0 +1,74 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_SHADERVARIANTS_H
+#define TACTICGAME_SHADERVARIANTS_H
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+
+class ShaderCache;
+
+// Every #define permutation of one vertex/fragment source pair. Variant
+// `mask` is built with flags[k] defined for each set bit k.
+//
+// build() first takes whatever the cache has, then submits every remaining
+// compile and link before querying a single status, so drivers with
+// background compiler threads (KHR_parallel_shader_compile, or most desktop
+// drivers by default) build the permutations in parallel.
+//
+// To rebuild without stalling a frame (hot reload), split build() in two:
+// submit(), then finish() on a later frame once ready() says the driver is
+// done. ready() only knows that with KHR_parallel_shader_compile; without
+// it, it is always true and finish() waits for the compiler.
+class ShaderVariants
+{
+public:
+    ShaderVariants(std::string vertexSource, std::string fragmentSource, std::vector<std::string> flags);
+    ~ShaderVariants();
+
+    ShaderVariants(const ShaderVariants&) = delete;
+    ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+    // `cache` may be null (always compile). Same as submit() + finish().
+    void build(ShaderCache* cache);
+
+    void submit(ShaderCache* cache);
+    bool ready() const;
+    // Collects the submitted programs; false (errors logged) if any failed
+    bool finish(ShaderCache* cache);
+
+    int count() const { return 1 << flags_.size(); }
+    Shader& get(std::uint32_t mask) const { return *shaders_[mask]; }
+    // Hands variant `mask` over to the caller
+    std::unique_ptr<Shader> release(std::uint32_t mask) { return std::move(shaders_[mask]); }
+
+    // `source` with #defines inserted after its #version line
+    static std::string withDefines(const std::string& source, const std::vector<std::string>& defines);
+
+private:
+    std::string vertexSource_;
+    std::string fragmentSource_;
+    std::vector<std::string> flags_;
+    std::vector<std::unique_ptr<Shader>> shaders_;
+
+    // Submitted but not yet collected
+    struct Pending
+    {
+        std::uint32_t mask;
+        std::uint64_t key;
+        unsigned int program;
+        unsigned int vs;
+        unsigned int fs;
+    };
+    std::vector<Pending> pending_;
+};
+
+
+#endif //TACTICGAME_SHADERVARIANTS_H
@@ -0,0 +1,184 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "ShadowMaps.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+// [-1, 1] clip space to [0, 1] texture space
+static const glm::mat4 kClipToTexture(0.5f, 0.0f, 0.0f, 0.0f,
+                                      0.0f, 0.5f, 0.0f, 0.0f,
+                                      0.0f, 0.0f, 0.5f, 0.0f,
+                                      0.5f, 0.5f, 0.5f, 1.0f);
+
+ShadowMaps::ShadowMaps(int staticSize, int overlaySize)
+        : nearZ_(0.0f),
+          farZ_(1.0f),
+          staticValid_(false),
+          staticRevision_(0),
+          staticRenders_(0),
+          savedViewport_{0, 0, 0, 0}
+{
+    createTarget(staticTarget_, staticSize);
+    createTarget(overlayTarget_, overlaySize);
+}
+
+ShadowMaps::~ShadowMaps()
+{
+    destroyTarget(staticTarget_);
+    destroyTarget(overlayTarget_);
+}
+
+void ShadowMaps::createTarget(Target& target, int size)
+{
+    target.size = size;
+
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, size, size, 0,
+                 GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);
+    // Hardware compare + bilinear: each tap is already a 2x2 PCF
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    // Outside the map is lit
+    const float border[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, target.texture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+
+    // Start out lit until something is rendered
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void ShadowMaps::destroyTarget(Target& target)
+{
+    glDeleteFramebuffers(1, &target.fbo);
+    glDeleteTextures(1, &target.texture);
+    target = Target{};
+}
+
+void ShadowMaps::setLight(const glm::vec3& direction, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    const glm::vec3 dir = glm::normalize(direction);
+    if (staticValid_ && dir == direction_ && boundsMin == boundsMin_ && boundsMax == boundsMax_) {
+        return;
+    }
+    direction_ = dir;
+    boundsMin_ = boundsMin;
+    boundsMax_ = boundsMax;
+
+    // Look along the light at the board's centre, from outside it
+    const glm::vec3 center = 0.5f * (boundsMin + boundsMax);
+    const float radius = glm::length(boundsMax - boundsMin) * 0.5f + 1.0f;
+    const glm::vec3 up = std::fabs(dir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    lightView_ = glm::lookAt(center - dir * radius, center, up);
+
+    // Tight light-space box around the board's corners
+    glm::vec3 lo(1e30f);
+    glm::vec3 hi(-1e30f);
+    for (int k = 0; k < 8; ++k) {
+        const glm::vec3 corner((k & 1) ? boundsMax.x : boundsMin.x,
+                               (k & 2) ? boundsMax.y : boundsMin.y,
+                               (k & 4) ? boundsMax.z : boundsMin.z);
+        const glm::vec3 p = glm::vec3(lightView_ * glm::vec4(corner, 1.0f));
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    // View space looks down -z
+    nearZ_ = -hi.z - 0.5f;
+    farZ_  = -lo.z + 0.5f;
+    staticMatrix_ = glm::ortho(lo.x, hi.x, lo.y, hi.y, nearZ_, farZ_) * lightView_;
+    staticValid_ = false;
+}
+
+void ShadowMaps::begin(const Target& target)
+{
+    glGetIntegerv(GL_VIEWPORT, savedViewport_);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glViewport(0, 0, target.size, target.size);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    // Push depths back a little to keep lit surfaces from self-shadowing
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);
+}
+
+void ShadowMaps::end()
+{
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(savedViewport_[0], savedViewport_[1], savedViewport_[2], savedViewport_[3]);
+}
+
+void ShadowMaps::beginStatic()
+{
+    begin(staticTarget_);
+}
+
+void ShadowMaps::endStatic(std::uint32_t mapRevision)
+{
+    end();
+    staticValid_ = true;
+    staticRevision_ = mapRevision;
+    ++staticRenders_;
+}
+
+void ShadowMaps::beginOverlay(const glm::vec3& unitsMin, const glm::vec3& unitsMax)
+{
+    glm::vec2 lo(1e30f);
+    glm::vec2 hi(-1e30f);
+    for (int k = 0; k < 8; ++k) {
+        const glm::vec3 corner((k & 1) ? unitsMax.x : unitsMin.x,
+                               (k & 2) ? unitsMax.y : unitsMin.y,
+                               (k & 4) ? unitsMax.z : unitsMin.z);
+        const glm::vec4 p = lightView_ * glm::vec4(corner, 1.0f);
+        lo = glm::min(lo, glm::vec2(p.x, p.y));
+        hi = glm::max(hi, glm::vec2(p.x, p.y));
+    }
+
+    // Power-of-two extent on a texel-aligned origin: the fit only changes in
+    // whole steps, so a moving unit's shadow doesn't shimmer
+    const float extent = std::max(std::max(hi.x - lo.x, hi.y - lo.y), 1.0f);
+    const float size = std::exp2(std::ceil(std::log2(extent)));
+    // One texel of slack so snapping down never crops the far edge
+    const float texel = size / (float)(overlayTarget_.size - 1);
+    const float range = texel * (float)overlayTarget_.size;
+    const float x0 = std::floor(lo.x / texel) * texel;
+    const float y0 = std::floor(lo.y / texel) * texel;
+    overlayMatrix_ = glm::ortho(x0, x0 + range, y0, y0 + range, nearZ_, farZ_) * lightView_;
+
+    begin(overlayTarget_);
+}
+
+void ShadowMaps::endOverlay()
+{
+    end();
+}
+
+void ShadowMaps::clearOverlay()
+{
+    begin(overlayTarget_);
+    end();
+}
+
+glm::mat4 ShadowMaps::staticSampleMatrix() const
+{
+    return kClipToTexture * staticMatrix_;
+}
+
+glm::mat4 ShadowMaps::overlaySampleMatrix() const
+{
+    return kClipToTexture * overlayMatrix_;
+}
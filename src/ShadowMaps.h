@@ -0,0 +1,114 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_SHADOWMAPS_H
+#define TACTICGAME_SHADOWMAPS_H
+
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Shadow filtering: Hard is one (hardware 2x2 bilinear) compare, the PCF
+// levels average a 3x3 or 5x5 grid of them
+enum class ShadowQuality : std::uint8_t
+{
+    Off,
+    Hard,
+    Pcf3x3,
+    Pcf5x5,
+};
+
+// Kernel radius in texels for the shader's PCF loop
+inline int shadowPcfRadius(ShadowQuality quality)
+{
+    return quality == ShadowQuality::Pcf5x5 ? 2 : quality == ShadowQuality::Pcf3x3 ? 1 : 0;
+}
+
+// Depth targets for a directional light.
+//
+//  - The static map covers the whole board and holds the terrain. It is
+//    cached: the caller re-renders it only when staticDirty() says the
+//    light or the board changed.
+//  - The overlay is a smaller map holding just the units, refit every frame
+//    to the box around them (snapped to its own texel grid so shadows don't
+//    crawl as units move) and composited with the static one in the shader.
+//
+// Both use the same light view and depth range, so they line up. The
+// sample matrices map world space straight to [0, 1] texture coordinates
+// and depth for a sampler2DShadow.
+class ShadowMaps
+{
+public:
+    ShadowMaps(int staticSize = 2048, int overlaySize = 1024);
+    ~ShadowMaps();
+
+    ShadowMaps(const ShadowMaps&) = delete;
+    ShadowMaps& operator=(const ShadowMaps&) = delete;
+
+    // `direction` is the way the light travels; the box is the board's
+    // world-space bounds (everything that can cast or receive)
+    void setLight(const glm::vec3& direction, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+    bool staticDirty(std::uint32_t mapRevision) const { return !staticValid_ || staticRevision_ != mapRevision; }
+    // Forces the next staticDirty(), e.g. after the depth program changed
+    void invalidateStatic() { staticValid_ = false; }
+    // Bind, clear and set up the static target; draw the terrain with
+    // staticMatrix() in between
+    void beginStatic();
+    void endStatic(std::uint32_t mapRevision);
+
+    // Same for the overlay, fitted to the world-space box around the units
+    void beginOverlay(const glm::vec3& unitsMin, const glm::vec3& unitsMax);
+    void endOverlay();
+    // Overlay with nothing in it (no units in view)
+    void clearOverlay();
+
+    // World -> light clip space, for rendering into the maps
+    const glm::mat4& staticMatrix() const { return staticMatrix_; }
+    const glm::mat4& overlayMatrix() const { return overlayMatrix_; }
+    // World -> shadow texture coordinates + depth, for sampling
+    glm::mat4 staticSampleMatrix() const;
+    glm::mat4 overlaySampleMatrix() const;
+
+    unsigned int staticTexture() const { return staticTarget_.texture; }
+    unsigned int overlayTexture() const { return overlayTarget_.texture; }
+
+    // Times the static map has been rendered, for stats
+    int staticRenders() const { return staticRenders_; }
+
+private:
+    struct Target
+    {
+        unsigned int fbo = 0;
+        unsigned int texture = 0;
+        int size = 0;
+    };
+
+    Target staticTarget_;
+    Target overlayTarget_;
+
+    glm::vec3 direction_{0.0f};
+    glm::vec3 boundsMin_{0.0f};
+    glm::vec3 boundsMax_{0.0f};
+    glm::mat4 lightView_{1.0f};
+    float nearZ_;
+    float farZ_;
+    glm::mat4 staticMatrix_{1.0f};
+    glm::mat4 overlayMatrix_{1.0f};
+
+    bool staticValid_;
+    std::uint32_t staticRevision_;
+    int staticRenders_;
+
+    // Viewport to restore after a pass
+    int savedViewport_[4];
+
+    static void createTarget(Target& target, int size);
+    static void destroyTarget(Target& target);
+    void begin(const Target& target);
+    void end();
+};
+
+
+#endif //TACTICGAME_SHADOWMAPS_H
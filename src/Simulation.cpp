@@ -0,0 +1,178 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Simulation.h"
+#include "Replay.h"
+#include "TileMap.h"
+#include <cmath>
+
+std::uint8_t SimInput::bits() const
+{
+    return (std::uint8_t)((moveForward ? 1 : 0) | (moveBack ? 2 : 0) | (moveLeft ? 4 : 0) | (moveRight ? 8 : 0));
+}
+
+SimInput SimInput::fromBits(std::uint8_t bits)
+{
+    SimInput input;
+    input.moveForward = (bits & 1) != 0;
+    input.moveBack    = (bits & 2) != 0;
+    input.moveLeft    = (bits & 4) != 0;
+    input.moveRight   = (bits & 8) != 0;
+    return input;
+}
+
+Simulation::Simulation(const TileMap& map)
+        : map_(map),
+          tick_(0),
+          pathfinder_(map),
+          recorder_(nullptr)
+{
+}
+
+void Simulation::tick(const SimInput& input)
+{
+    const float dt = (float)kTickSeconds;
+
+    if (recorder_) {
+        recorder_->record(tick_, input, pending_.data(), pending_.size());
+    }
+    for (const SimCommand& command : pending_) {
+        switch (command.type) {
+            case SimCommandType::SetTarget:
+                setTarget(command.unit, command.tile);
+                break;
+        }
+    }
+    pending_.clear();
+
+    std::vector<glm::vec3>& pos = units_.positions();
+    units_.prevPositions() = pos;
+
+    // --- Sphere movement with W/S/A/D ---
+    if (units_.alive(player_)) {
+        const std::uint32_t p = units_.indexOf(player_);
+        const float step = units_.moveSpeeds()[p] * dt;
+        if (input.moveForward) {
+            pos[p].z -= step;
+        }
+        if (input.moveBack) {
+            pos[p].z += step;
+        }
+        if (input.moveLeft) {
+            pos[p].x -= step;
+        }
+        if (input.moveRight) {
+            pos[p].x += step;
+        }
+    }
+
+    moveTowardTargets(dt);
+
+    ++tick_;
+}
+
+void Simulation::moveTowardTargets(float dt)
+{
+    std::vector<glm::vec3>& pos = units_.positions();
+    std::vector<glm::ivec2>& targets = units_.targetTiles();
+    std::vector<glm::ivec2>& waypoints = units_.waypoints();
+    const std::vector<float>& speeds = units_.moveSpeeds();
+    std::vector<glm::vec2>& facings = units_.facings();
+
+    const size_t count = units_.size();
+    for (size_t u = 0; u < count; ++u)
+    {
+        if (targets[u] == kNoTarget) {
+            continue;
+        }
+
+        // Between tiles: take the next step down the target's flow field
+        if (waypoints[u] == kNoTarget) {
+            const glm::ivec2 tile = map_.tileAt(pos[u]);
+            if (tile == targets[u]) {
+                targets[u] = kNoTarget;
+                continue;
+            }
+            const glm::ivec2 next = pathfinder_.nextStep(pathfinder_.flowField(targets[u]), tile);
+            if (next == tile) {
+                targets[u] = kNoTarget; // unreachable from here
+                continue;
+            }
+            waypoints[u] = next;
+            pos[u].y += map_.topY(next.x, next.y) - map_.topY(tile.x, tile.y);
+        }
+
+        const glm::vec3 centre = map_.tileCenter(waypoints[u].x, waypoints[u].y);
+        const float dx = centre.x - pos[u].x;
+        const float dz = centre.z - pos[u].z;
+        const float dist = std::sqrt(dx * dx + dz * dz);
+        const float step = speeds[u] * dt;
+        if (dist <= step) {
+            pos[u].x = centre.x;
+            pos[u].z = centre.z;
+            waypoints[u] = kNoTarget;
+        } else {
+            facings[u] = glm::vec2(dx / dist, dz / dist);
+            pos[u].x += facings[u].x * step;
+            pos[u].z += facings[u].y * step;
+        }
+    }
+}
+
+void Simulation::restore(std::uint64_t tick, UnitHandle player)
+{
+    tick_ = tick;
+    player_ = player;
+    pending_.clear();
+}
+
+void Simulation::setPlayerPosition(const glm::vec3& pos)
+{
+    if (!units_.alive(player_)) {
+        UnitDesc desc;
+        desc.position  = pos;
+        desc.moveSpeed = 1.2f; // the old 0.02 per frame at 60 fps
+        player_ = units_.create(desc);
+        return;
+    }
+    const std::uint32_t p = units_.indexOf(player_);
+    units_.positions()[p]     = pos;
+    units_.prevPositions()[p] = pos; // teleport, nothing to interpolate from
+}
+
+glm::vec3 Simulation::playerPosition() const
+{
+    return units_.alive(player_) ? units_.positions()[units_.indexOf(player_)] : glm::vec3(0.0f);
+}
+
+glm::vec3 Simulation::playerPosition(float alpha) const
+{
+    if (!units_.alive(player_)) {
+        return glm::vec3(0.0f);
+    }
+    const std::uint32_t p = units_.indexOf(player_);
+    return glm::mix(units_.prevPositions()[p], units_.positions()[p], alpha);
+}
+
+void Simulation::setTarget(UnitHandle unit, glm::ivec2 tile)
+{
+    if (tile != kNoTarget && !map_.inBounds(tile.x, tile.y)) {
+        return;
+    }
+    if (units_.alive(unit)) {
+        units_.targetTiles()[units_.indexOf(unit)] = tile;
+    }
+}
+
+void Simulation::interpolatePositions(float alpha, std::vector<glm::vec3>& out) const
+{
+    const std::vector<glm::vec3>& prev = units_.prevPositions();
+    const std::vector<glm::vec3>& cur  = units_.positions();
+    const size_t count = units_.size();
+    out.resize(count);
+    for (size_t u = 0; u < count; ++u)
+    {
+        out[u] = prev[u] + (cur[u] - prev[u]) * alpha;
+    }
+}
@@ -0,0 +1,111 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_SIMULATION_H
+#define TACTICGAME_SIMULATION_H
+
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Pathfinder.h"
+#include "UnitStore.h"
+
+class ReplayRecorder;
+class TileMap;
+
+// Input state sampled once per rendered frame and applied to every
+// simulation tick run during that frame
+struct SimInput
+{
+    bool moveForward = false;
+    bool moveBack    = false;
+    bool moveLeft    = false;
+    bool moveRight   = false;
+
+    // One bit per flag, in declaration order (replay logs store this)
+    std::uint8_t bits() const;
+    static SimInput fromBits(std::uint8_t bits);
+};
+
+enum class SimCommandType : std::uint8_t
+{
+    SetTarget, // walk `unit` to `tile` (kNoTarget stops it)
+};
+
+// An order applied at the start of a tick. POD, stored as-is in replay logs.
+struct SimCommand
+{
+    UnitHandle unit;
+    glm::ivec2 tile{-1, -1};
+    SimCommandType type = SimCommandType::SetTarget;
+    std::uint8_t reserved[3] = {};
+};
+static_assert(sizeof(SimCommand) == 20, "SimCommand layout is part of the replay format");
+
+// Gameplay state advanced in fixed ticks. No GL or GLFW in here, so results
+// don't depend on render rate and the same code runs headless.
+//
+// Lockstep: after setup, state only changes inside tick(), from that tick's
+// input and the commands submit()ted before it. A snapshot plus the
+// (tick, input, commands) log therefore replays a match exactly.
+class Simulation
+{
+public:
+    static constexpr double kTickRate    = 60.0;
+    static constexpr double kTickSeconds = 1.0 / kTickRate;
+
+    explicit Simulation(const TileMap& map);
+
+    // Applies the pending commands, then advances one tick
+    void tick(const SimInput& input);
+
+    // Queues a command for the start of the next tick
+    void submit(const SimCommand& command) { pending_.push_back(command); }
+    // Sees every tick's input and commands as it runs (null = none)
+    void setRecorder(ReplayRecorder* recorder) { recorder_ = recorder; }
+
+    // Snapshot loading: sets the tick counter and player handle after the
+    // unit store has been restored; drops pending commands
+    void restore(std::uint64_t tick, UnitHandle player);
+
+    // The unit driven by SimInput (created on first use)
+    UnitHandle player() const { return player_; }
+    void setPlayerPosition(const glm::vec3& pos);
+    glm::vec3 playerPosition() const;
+    // Position blended between the previous and current tick for rendering
+    glm::vec3 playerPosition(float alpha) const;
+
+    // Orders a unit to walk to a tile (kNoTarget to stop), immediately; for
+    // setup, use submit() once ticks are running. Units heading for the same
+    // tile share one cached flow field.
+    void setTarget(UnitHandle unit, glm::ivec2 tile);
+
+    // Path, flow-field and movement-range queries over the board
+    Pathfinder& pathfinder() { return pathfinder_; }
+
+    UnitStore& units() { return units_; }
+    const UnitStore& units() const { return units_; }
+    // Every unit's position blended between ticks, in dense order
+    void interpolatePositions(float alpha, std::vector<glm::vec3>& out) const;
+
+    std::uint64_t tickCount() const { return tick_; }
+
+private:
+    const TileMap& map_;
+    std::uint64_t tick_;
+
+    UnitStore units_;
+    UnitHandle player_;
+    Pathfinder pathfinder_;
+
+    std::vector<SimCommand> pending_;
+    ReplayRecorder* recorder_;
+
+    void moveTowardTargets(float dt);
+};
+
+
+#endif //TACTICGAME_SIMULATION_H
@@ -0,0 +1,206 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "Snapshot.h"
+#include "Simulation.h"
+#include "TileMap.h"
+#include <cstring>
+
+namespace {
+
+constexpr std::uint64_t kSectionAlign = 16;
+
+std::uint64_t alignUp(std::uint64_t value)
+{
+    return (value + kSectionAlign - 1) & ~(kSectionAlign - 1);
+}
+
+// Section order in SnapshotHeader::sectionOffsets
+enum Section
+{
+    kHeights,
+    kTypes,
+    kPositions,
+    kPrevPositions,
+    kTargets,
+    kWaypoints,
+    kSpeeds,
+    kScales,
+    kFacings,
+    kHp,
+    kTeams,
+    kVision,
+    kDenseToSlot,
+    kGenerations,
+    kFreeSlots,
+};
+
+static_assert(sizeof(glm::vec3) == 12 && sizeof(glm::vec2) == 8 && sizeof(glm::ivec2) == 8,
+              "snapshot arrays are stored as raw glm vectors");
+
+// Bytes of each section for the header's counts
+void sectionSizes(const SnapshotHeader& h, std::uint64_t sizes[kSnapshotSections])
+{
+    const std::uint64_t tiles = (std::uint64_t)h.width * h.depth;
+    const std::uint64_t n = h.unitCount;
+    sizes[kHeights]       = tiles * sizeof(float);
+    sizes[kTypes]         = tiles;
+    sizes[kPositions]     = n * sizeof(glm::vec3);
+    sizes[kPrevPositions] = n * sizeof(glm::vec3);
+    sizes[kTargets]       = n * sizeof(glm::ivec2);
+    sizes[kWaypoints]     = n * sizeof(glm::ivec2);
+    sizes[kSpeeds]        = n * sizeof(float);
+    sizes[kScales]        = n * sizeof(float);
+    sizes[kFacings]       = n * sizeof(glm::vec2);
+    sizes[kHp]            = n * sizeof(std::int16_t);
+    sizes[kTeams]         = n;
+    sizes[kVision]        = n;
+    sizes[kDenseToSlot]   = n * sizeof(std::uint32_t);
+    sizes[kGenerations]   = (std::uint64_t)h.slotCount * sizeof(std::uint32_t);
+    sizes[kFreeSlots]     = (std::uint64_t)h.freeSlotCount * sizeof(std::uint32_t);
+}
+
+// Header of a well-formed blob (magic, version, every section in bounds), or null
+const SnapshotHeader* validHeader(const std::uint8_t* data, std::size_t size)
+{
+    if (!data || size < sizeof(SnapshotHeader)) {
+        return nullptr;
+    }
+    const SnapshotHeader* h = reinterpret_cast<const SnapshotHeader*>(data);
+    if (std::memcmp(h->magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 || h->version != kSnapshotVersion) {
+        return nullptr;
+    }
+    std::uint64_t sizes[kSnapshotSections];
+    sectionSizes(*h, sizes);
+    for (int s = 0; s < kSnapshotSections; ++s) {
+        const std::uint64_t offset = h->sectionOffsets[s];
+        if (offset % kSectionAlign != 0 || offset > size || sizes[s] > size - offset) {
+            return nullptr;
+        }
+    }
+    return h;
+}
+
+template <typename T>
+void copySection(const std::uint8_t* data, const SnapshotHeader& h, int section, std::size_t count, std::vector<T>& out)
+{
+    out.resize(count);
+    if (count > 0) {
+        std::memcpy(out.data(), data + h.sectionOffsets[section], count * sizeof(T));
+    }
+}
+
+} // namespace
+
+void saveSnapshot(const TileMap& map, const Simulation& simulation, std::vector<std::uint8_t>& out)
+{
+    const UnitStore& units = simulation.units();
+
+    SnapshotHeader h{};
+    std::memcpy(h.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    h.version          = kSnapshotVersion;
+    h.tick             = simulation.tickCount();
+    h.width            = (std::uint32_t)map.width();
+    h.depth            = (std::uint32_t)map.depth();
+    h.unitCount        = (std::uint32_t)units.size();
+    h.slotCount        = (std::uint32_t)units.generations().size();
+    h.freeSlotCount    = (std::uint32_t)units.freeSlots().size();
+    h.playerSlot       = simulation.player().slot;
+    h.playerGeneration = simulation.player().generation;
+
+    const void* sources[kSnapshotSections] = {
+            map.heights().data(),
+            map.types().data(),
+            units.positions().data(),
+            units.prevPositions().data(),
+            units.targetTiles().data(),
+            units.waypoints().data(),
+            units.moveSpeeds().data(),
+            units.scales().data(),
+            units.facings().data(),
+            units.hp().data(),
+            units.teams().data(),
+            units.visionRadii().data(),
+            units.denseToSlot().data(),
+            units.generations().data(),
+            units.freeSlots().data(),
+    };
+    std::uint64_t sizes[kSnapshotSections];
+    sectionSizes(h, sizes);
+    std::uint64_t end = sizeof(SnapshotHeader);
+    for (int s = 0; s < kSnapshotSections; ++s) {
+        h.sectionOffsets[s] = alignUp(end);
+        end = h.sectionOffsets[s] + sizes[s];
+    }
+
+    // Zeroed, so the padding (and therefore snapshotHash) is deterministic
+    out.assign((size_t)end, 0);
+    std::memcpy(out.data(), &h, sizeof(h));
+    for (int s = 0; s < kSnapshotSections; ++s) {
+        if (sizes[s] > 0) {
+            std::memcpy(out.data() + h.sectionOffsets[s], sources[s], (size_t)sizes[s]);
+        }
+    }
+}
+
+std::unique_ptr<TileMap> loadSnapshotBoard(const std::uint8_t* data, std::size_t size)
+{
+    const SnapshotHeader* h = validHeader(data, size);
+    if (!h || h->width == 0 || h->depth == 0) {
+        return nullptr;
+    }
+    return std::make_unique<TileMap>((int)h->width, (int)h->depth,
+                                     reinterpret_cast<const float*>(data + h->sectionOffsets[kHeights]),
+                                     data + h->sectionOffsets[kTypes]);
+}
+
+bool loadSnapshotState(const std::uint8_t* data, std::size_t size, Simulation& simulation)
+{
+    const SnapshotHeader* h = validHeader(data, size);
+    if (!h) {
+        return false;
+    }
+    const size_t n = h->unitCount;
+
+    // Reject slot tables that don't describe the dense arrays
+    const std::uint32_t* denseToSlot = reinterpret_cast<const std::uint32_t*>(data + h->sectionOffsets[kDenseToSlot]);
+    for (size_t u = 0; u < n; ++u) {
+        if (denseToSlot[u] >= h->slotCount) {
+            return false;
+        }
+    }
+    const std::uint32_t* freeSlots = reinterpret_cast<const std::uint32_t*>(data + h->sectionOffsets[kFreeSlots]);
+    for (size_t f = 0; f < h->freeSlotCount; ++f) {
+        if (freeSlots[f] >= h->slotCount) {
+            return false;
+        }
+    }
+
+    UnitStore& units = simulation.units();
+    copySection(data, *h, kPositions, n, units.positions());
+    copySection(data, *h, kPrevPositions, n, units.prevPositions());
+    copySection(data, *h, kTargets, n, units.targetTiles());
+    copySection(data, *h, kWaypoints, n, units.waypoints());
+    copySection(data, *h, kSpeeds, n, units.moveSpeeds());
+    copySection(data, *h, kScales, n, units.scales());
+    copySection(data, *h, kFacings, n, units.facings());
+    copySection(data, *h, kHp, n, units.hp());
+    copySection(data, *h, kTeams, n, units.teams());
+    copySection(data, *h, kVision, n, units.visionRadii());
+    units.restoreSlots(denseToSlot, n,
+                       reinterpret_cast<const std::uint32_t*>(data + h->sectionOffsets[kGenerations]), h->slotCount,
+                       freeSlots, h->freeSlotCount);
+
+    simulation.restore(h->tick, UnitHandle{h->playerSlot, h->playerGeneration});
+    return true;
+}
+
+std::uint64_t snapshotHash(const std::vector<std::uint8_t>& snapshot)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::uint8_t byte : snapshot) {
+        hash = (hash ^ byte) * 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,68 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_SNAPSHOT_H
+#define TACTICGAME_SNAPSHOT_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Simulation;
+class TileMap;
+
+// Binary snapshot of the whole game state: the board, every unit component,
+// the unit slot table (so handles taken before a snapshot still resolve
+// after it) and the tick counter. Same layout rules as MapFile: a fixed
+// header, then one 16-byte aligned POD array per field, so saving and
+// loading are a memcpy per array with no per-unit work or allocation.
+//
+//   SnapshotHeader
+//   heights, types                       TileMap layout
+//   positions, prevPositions, targets,   UnitStore dense arrays, unitCount each
+//   waypoints, speeds, scales, facings,
+//   hp, teams, vision, denseToSlot
+//   generations                          uint32[slotCount]
+//   freeSlots                            uint32[freeSlotCount]
+//
+// Derived state (flow-field caches, fog of war) isn't stored; it's rebuilt
+// from the above on demand.
+constexpr char kSnapshotMagic[4] = {'T', 'G', 'S', 'N'};
+constexpr std::uint32_t kSnapshotVersion = 1;
+constexpr int kSnapshotSections = 15;
+
+struct SnapshotHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t tick;
+    std::uint32_t width;
+    std::uint32_t depth;
+    std::uint32_t unitCount;
+    std::uint32_t slotCount;
+    std::uint32_t freeSlotCount;
+    std::uint32_t playerSlot;
+    std::uint32_t playerGeneration;
+    std::uint32_t reserved;
+    std::uint64_t sectionOffsets[kSnapshotSections];
+};
+static_assert(sizeof(SnapshotHeader) == 48 + 8 * kSnapshotSections, "SnapshotHeader layout is part of the format");
+
+// Replaces `out` with the snapshot, reusing its capacity
+void saveSnapshot(const TileMap& map, const Simulation& simulation, std::vector<std::uint8_t>& out);
+
+// The board of a snapshot, or null if the blob isn't a valid snapshot.
+// Build the Simulation on it, then loadSnapshotState() into that.
+std::unique_ptr<TileMap> loadSnapshotBoard(const std::uint8_t* data, std::size_t size);
+// Units, slot table and tick; `simulation` should run on the board from
+// loadSnapshotBoard() of the same blob
+bool loadSnapshotState(const std::uint8_t* data, std::size_t size, Simulation& simulation);
+
+// FNV-1a over the blob; two runs that agree on this agree on every field
+std::uint64_t snapshotHash(const std::vector<std::uint8_t>& snapshot);
+
+
+#endif //TACTICGAME_SNAPSHOT_H
@@ -0,0 +1,151 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "SpatialGrid.h"
+#include "Frustum.h"
+#include "TileMap.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(const TileMap& map)
+        : map_(map),
+          cells_((size_t)map.chunkCount()),
+          units_(nullptr),
+          unitRadius_(0.0f),
+          cellStart_((size_t)map.chunkCount() + 1, 0)
+{
+    for (Cell& cell : cells_)
+    {
+        cell.builtRevision = 0;
+    }
+    refreshBounds();
+}
+
+void SpatialGrid::refreshBounds()
+{
+    for (int cz = 0; cz < map_.chunksZ(); ++cz)
+    {
+        for (int cx = 0; cx < map_.chunksX(); ++cx)
+        {
+            Cell& cell = cells_[cz * map_.chunksX() + cx];
+            if (cell.builtRevision == map_.chunkRevision(cx, cz)) {
+                continue;
+            }
+
+            const int i0 = cx * kChunkSize, i1 = std::min(i0 + kChunkSize, map_.width());
+            const int j0 = cz * kChunkSize, j1 = std::min(j0 + kChunkSize, map_.depth());
+            float top = -0.5f;
+            for (int i = i0; i < i1; ++i)
+            {
+                for (int j = j0; j < j1; ++j)
+                {
+                    if (map_.hasTile(i, j)) {
+                        top = std::max(top, map_.topY(i, j));
+                    }
+                }
+            }
+
+            const glm::vec3 first = map_.tileCenter(i0, j0);
+            const glm::vec3 last  = map_.tileCenter(i1 - 1, j1 - 1);
+            cell.min = glm::vec3(first.x - 0.5f, -0.5f, first.z - 0.5f);
+            cell.max = glm::vec3(last.x + 0.5f, top, last.z + 0.5f);
+            cell.terrainTop = top;
+            cell.builtRevision = map_.chunkRevision(cx, cz);
+        }
+    }
+}
+
+int SpatialGrid::cellAt(const glm::vec3& worldPos) const
+{
+    // Inverse of TileMap::tileCenter, clamped so off-board units land on the edge
+    int i = (int)std::floor(worldPos.x + map_.width() / 2.0f + 0.5f);
+    int j = (int)std::floor(worldPos.z + map_.depth() / 2.0f + 0.5f);
+    i = std::clamp(i, 0, map_.width() - 1);
+    j = std::clamp(j, 0, map_.depth() - 1);
+    return (j / kChunkSize) * map_.chunksX() + i / kChunkSize;
+}
+
+void SpatialGrid::setUnits(const std::vector<glm::vec3>& positions, float radius)
+{
+    units_ = &positions;
+    unitRadius_ = radius;
+
+    const float halfW = map_.width() / 2.0f + 0.5f;
+    const float halfD = map_.depth() / 2.0f + 0.5f;
+
+    // Counting sort: count per cell, prefix sum, scatter
+    std::fill(cellStart_.begin(), cellStart_.end(), 0);
+    offBoard_.clear();
+    unitCell_.resize(positions.size());
+    for (size_t u = 0; u < positions.size(); ++u)
+    {
+        const glm::vec3& p = positions[u];
+        if (p.x < -halfW || p.x > halfW - 1.0f || p.z < -halfD || p.z > halfD - 1.0f) {
+            unitCell_[u] = -1;
+            offBoard_.push_back((std::uint32_t)u);
+            continue;
+        }
+        unitCell_[u] = cellAt(p);
+        ++cellStart_[unitCell_[u] + 1];
+    }
+    for (size_t c = 1; c < cellStart_.size(); ++c)
+    {
+        cellStart_[c] += cellStart_[c - 1];
+    }
+
+    cellUnits_.resize(positions.size() - offBoard_.size());
+    cellCursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+    for (size_t u = 0; u < positions.size(); ++u)
+    {
+        if (unitCell_[u] >= 0) {
+            cellUnits_[cellCursor_[unitCell_[u]]++] = (std::uint32_t)u;
+        }
+    }
+}
+
+void SpatialGrid::query(const Frustum& frustum, std::vector<int>& visibleCells,
+                        std::vector<std::uint32_t>& visibleUnits) const
+{
+    visibleCells.clear();
+    visibleUnits.clear();
+
+    for (int c = 0; c < (int)cells_.size(); ++c)
+    {
+        const Cell& cell = cells_[c];
+        const std::uint32_t begin = cellStart_[c];
+        const std::uint32_t end   = units_ ? cellStart_[c + 1] : begin;
+
+        // Grow by a unit so spheres on the tallest tile or poking over the
+        // cell edge still count as inside
+        glm::vec3 min = cell.min;
+        glm::vec3 max = cell.max;
+        if (end > begin) {
+            const glm::vec3 pad(unitRadius_);
+            min = min - pad;
+            max = max + pad;
+            max.y += unitRadius_;
+        }
+
+        CullResult result = frustum.classifyAABB(min, max);
+        if (result == CullResult::Outside) {
+            continue;
+        }
+        visibleCells.push_back(c);
+
+        for (std::uint32_t k = begin; k < end; ++k)
+        {
+            std::uint32_t u = cellUnits_[k];
+            if (result == CullResult::Inside || frustum.intersectsSphere((*units_)[u], unitRadius_)) {
+                visibleUnits.push_back(u);
+            }
+        }
+    }
+
+    for (std::uint32_t u : offBoard_)
+    {
+        if (frustum.intersectsSphere((*units_)[u], unitRadius_)) {
+            visibleUnits.push_back(u);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_SPATIALGRID_H
+#define TACTICGAME_SPATIALGRID_H
+
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Frustum;
+class TileMap;
+
+// Uniform grid over the board with one cell per map chunk (kChunkSize
+// tiles), so a cell index is also the MapChunks chunk index. Units are
+// bucketed into cells with a counting sort each frame, and queries test
+// whole cells against the frustum first: cells fully outside are skipped,
+// fully inside accept everything, and only straddling cells test units.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(const TileMap& map);
+
+    // Re-derive cell heights for chunks edited since the last call
+    void refreshBounds();
+
+    // Bucket unit spheres (all the same radius); positions must outlive queries
+    void setUnits(const std::vector<glm::vec3>& positions, float radius);
+
+    // Visible cells (chunk indices) and visible unit indices into setUnits()
+    void query(const Frustum& frustum, std::vector<int>& visibleCells,
+               std::vector<std::uint32_t>& visibleUnits) const;
+
+    int cellCount() const { return (int)cells_.size(); }
+    int cellAt(const glm::vec3& worldPos) const;
+
+private:
+    struct Cell
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+        float terrainTop;
+        std::uint32_t builtRevision;
+    };
+
+    const TileMap& map_;
+    std::vector<Cell> cells_;
+
+    // Units grouped by cell: cellStart_[c] .. cellStart_[c + 1] in cellUnits_
+    const std::vector<glm::vec3>* units_;
+    float unitRadius_;
+    std::vector<std::uint32_t> cellStart_;
+    std::vector<std::uint32_t> cellUnits_;
+    std::vector<std::uint32_t> cellCursor_;
+    std::vector<int> unitCell_;
+    // Units off the board: not inside any cell's box, always tested one by one
+    std::vector<std::uint32_t> offBoard_;
+};
+
+
+#endif //TACTICGAME_SPATIALGRID_H
@@ -0,0 +1,177 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "StreamBuffer.h"
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+
+StreamBuffer::StreamBuffer(std::size_t regionBytes)
+        : buffer_(0),
+          regionBytes_(0),
+          region_(0),
+          head_(0),
+          persistent_(false),
+          persistentPtr_(nullptr),
+          fences_{}
+{
+    create(regionBytes);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    destroy(true);
+    deleteRetired();
+}
+
+void StreamBuffer::deleteRetired()
+{
+    if (!retired_.empty()) {
+        glDeleteBuffers((GLsizei)retired_.size(), retired_.data());
+        retired_.clear();
+    }
+}
+
+void StreamBuffer::create(std::size_t regionBytes)
+{
+    regionBytes_ = regionBytes;
+    const GLsizeiptr total = (GLsizeiptr)(regionBytes_ * kRegions);
+
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+
+    persistent_ = false;
+    persistentPtr_ = nullptr;
+#if defined(GL_VERSION_4_4)
+    if (GLAD_GL_VERSION_4_4) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, total, nullptr, flags);
+        persistentPtr_ = (std::uint8_t*)glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags);
+        persistent_ = persistentPtr_ != nullptr;
+        if (!persistent_) {
+            // Immutable storage can't be respecified; start over with a plain buffer
+            glDeleteBuffers(1, &buffer_);
+            glGenBuffers(1, &buffer_);
+            glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+        }
+    }
+#endif
+    if (!persistent_) {
+        glBufferData(GL_ARRAY_BUFFER, total, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    spdlog::info("StreamBuffer: {} x {} KiB, {}", kRegions, regionBytes_ / 1024,
+                 persistent_ ? "persistent mapping" : "unsynchronized maps");
+}
+
+void StreamBuffer::destroy(bool now)
+{
+    for (int r = 0; r < kRegions; ++r) {
+        if (fences_[r]) {
+            glDeleteSync((GLsync)fences_[r]);
+            fences_[r] = nullptr;
+        }
+    }
+    if (persistent_) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    if (now) {
+        glDeleteBuffers(1, &buffer_);
+    } else {
+        retired_.push_back(buffer_);
+    }
+    buffer_ = 0;
+    persistentPtr_ = nullptr;
+}
+
+void StreamBuffer::waitFence(int region)
+{
+    GLsync fence = (GLsync)fences_[region];
+    if (!fence) {
+        return;
+    }
+    // The region was last used kRegions frames ago, so this is almost
+    // always already signalled; flush in case the fence isn't submitted yet
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    while (result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+    }
+    glDeleteSync(fence);
+    fences_[region] = nullptr;
+}
+
+void StreamBuffer::beginFrame()
+{
+    region_ = (region_ + 1) % kRegions;
+    head_ = 0;
+    waitFence(region_);
+}
+
+void StreamBuffer::endFrame()
+{
+    if (fences_[region_]) {
+        glDeleteSync((GLsync)fences_[region_]);
+    }
+    fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Nothing this frame references a grown-out buffer any more
+    deleteRetired();
+}
+
+StreamAllocation StreamBuffer::allocate(std::size_t bytes, std::size_t alignment)
+{
+    StreamAllocation allocation;
+    if (bytes == 0) {
+        return allocation;
+    }
+
+    std::size_t start = (head_ + alignment - 1) / alignment * alignment;
+    if (start + bytes > regionBytes_) {
+        // This frame outgrew its region. Earlier allocations this frame may
+        // still be bound (e.g. the frame UBO range), so the old buffer is only
+        // deleted in endFrame(); GL keeps it alive for draws in flight.
+        std::size_t grown = regionBytes_ * 2;
+        while (grown < bytes + alignment) {
+            grown *= 2;
+        }
+        spdlog::warn("StreamBuffer: frame needs more than {} KiB, growing to {} KiB",
+                     regionBytes_ / 1024, grown / 1024);
+        destroy(false);
+        create(grown);
+        region_ = 0;
+        head_ = 0;
+        start = 0;
+    }
+
+    const std::size_t offset = (std::size_t)region_ * regionBytes_ + start;
+    if (persistent_) {
+        allocation.ptr = persistentPtr_ + offset;
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+        allocation.ptr = glMapBufferRange(GL_ARRAY_BUFFER, (GLintptr)offset, (GLsizeiptr)bytes,
+                                          GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+                                          GL_MAP_INVALIDATE_RANGE_BIT);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (!allocation.ptr) {
+            return allocation;
+        }
+    }
+    allocation.offset = offset;
+    allocation.size = bytes;
+    head_ = start + bytes;
+    return allocation;
+}
+
+void StreamBuffer::commit(const StreamAllocation& allocation)
+{
+    // Coherent persistent mappings need nothing; plain maps must be
+    // released before a draw may source them
+    if (!persistent_ && allocation.valid()) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer_);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
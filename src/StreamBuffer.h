@@ -0,0 +1,84 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_STREAMBUFFER_H
+#define TACTICGAME_STREAMBUFFER_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One allocate() result. ptr is write-only mapped memory valid until
+// commit(); offset is where the data sits inside StreamBuffer::id().
+struct StreamAllocation
+{
+    void* ptr = nullptr;
+    std::size_t offset = 0;
+    std::size_t size = 0;
+
+    bool valid() const { return ptr != nullptr; }
+};
+
+// Ring buffer for per-frame dynamic data (instances, uniforms, debug
+// geometry). Split into kRegions frame-sized regions; each frame writes
+// only its own region, and a fence per region guarantees the GPU is done
+// with it before it comes round again, so writes never stall on the GPU.
+//
+// With GL 4.4 the buffer is allocated with glBufferStorage and mapped once
+// persistently; on 3.3 every allocation is a glMapBufferRange with
+// GL_MAP_UNSYNCHRONIZED_BIT (the fences provide the synchronisation).
+//
+//   beginFrame();
+//   StreamAllocation a = stream.allocate(bytes);
+//   ... write a.ptr ...
+//   stream.commit(a);      // before any draw that reads it
+//   glVertexAttribPointer(..., (void*)a.offset);
+//   endFrame();            // after the frame's last draw
+class StreamBuffer
+{
+public:
+    static constexpr int kRegions = 3;
+
+    explicit StreamBuffer(std::size_t regionBytes = 4 * 1024 * 1024);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Waits for (normally long finished) GPU use of the next region
+    void beginFrame();
+    // Fences the current region
+    void endFrame();
+
+    // Sub-allocates from this frame's region. Grows the ring if the frame
+    // outgrows it, which changes id(), so re-read it after every allocate().
+    StreamAllocation allocate(std::size_t bytes, std::size_t alignment = 16);
+    // Makes the written data visible to GL (unmaps on the 3.3 path)
+    void commit(const StreamAllocation& allocation);
+
+    unsigned int id() const { return buffer_; }
+    bool persistent() const { return persistent_; }
+    std::size_t regionBytes() const { return regionBytes_; }
+    // Bytes allocated so far this frame
+    std::size_t frameBytes() const { return head_; }
+
+private:
+    unsigned int buffer_;
+    std::size_t regionBytes_;
+    int region_;
+    std::size_t head_; // offset inside the current region
+    bool persistent_;
+    std::uint8_t* persistentPtr_;
+    void* fences_[kRegions];
+    std::vector<unsigned int> retired_; // replaced by a grow, deleted at endFrame()
+
+    void create(std::size_t regionBytes);
+    void destroy(bool now);
+    void deleteRetired();
+    void waitFence(int region);
+};
+
+
+#endif //TACTICGAME_STREAMBUFFER_H
@@ -0,0 +1,416 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "TextureManager.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+TextureManager::TextureManager(int workerThreads)
+        : placeholder_(0),
+          placeholderArray_(0),
+          uploadPBO_(0),
+          inFlight_(0),
+          stopping_(false)
+{
+    // Mid grey, so unloaded tiles read as "untextured" instead of black
+    const unsigned char grey[4] = { 160, 160, 160, 255 };
+    glGenTextures(1, &placeholder_);
+    glBindTexture(GL_TEXTURE_2D, placeholder_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // Single-layer stand-in for array textures (sampler2DArray needs one)
+    glGenTextures(1, &placeholderArray_);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, placeholderArray_);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, 1, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glGenBuffers(1, &uploadPBO_);
+
+    if (workerThreads < 1) {
+        workerThreads = 1;
+    }
+    for (int i = 0; i < workerThreads; ++i)
+    {
+        workers_.emplace_back(&TextureManager::workerLoop, this);
+    }
+}
+
+TextureManager::~TextureManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : workers_)
+    {
+        t.join();
+    }
+
+    for (DecodedImage& image : uploadQueue_)
+    {
+        stbi_image_free(image.pixels);
+    }
+    for (Entry& entry : entries_)
+    {
+        if (entry.texture) {
+            glDeleteTextures(1, &entry.texture);
+        }
+        if (entry.building) {
+            glDeleteTextures(1, &entry.building);
+        }
+    }
+    glDeleteTextures(1, &placeholder_);
+    glDeleteTextures(1, &placeholderArray_);
+    glDeleteBuffers(1, &uploadPBO_);
+}
+
+TextureHandle TextureManager::load(const std::string& path)
+{
+    auto it = byPath_.find(path);
+    if (it != byPath_.end()) {
+        return it->second;
+    }
+
+    TextureHandle handle = (TextureHandle)entries_.size();
+    Entry entry;
+    entry.path = path;
+    entries_.push_back(entry);
+    byPath_.emplace(path, handle);
+    queueDecodes(handle);
+    return handle;
+}
+
+TextureHandle TextureManager::loadArray(const std::vector<std::string>& layerPaths, int width, int height)
+{
+    std::string key = "array:";
+    for (const std::string& p : layerPaths)
+    {
+        key += p;
+        key += ';';
+    }
+    auto it = byPath_.find(key);
+    if (it != byPath_.end()) {
+        return it->second;
+    }
+
+    TextureHandle handle = (TextureHandle)entries_.size();
+    Entry entry;
+    entry.path       = key;
+    entry.isArray    = true;
+    entry.width      = width;
+    entry.height     = height;
+    entry.layers     = (int)layerPaths.size();
+    entry.layersLeft = entry.layers;
+    entry.layerPaths = layerPaths;
+    entries_.push_back(entry);
+    byPath_.emplace(key, handle);
+    queueDecodes(handle);
+    return handle;
+}
+
+void TextureManager::queueDecodes(TextureHandle handle)
+{
+    const Entry& entry = entries_[handle];
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entry.isArray) {
+            for (int layer = 0; layer < entry.layers; ++layer)
+            {
+                decodeQueue_.push_back(DecodeJob{handle, entry.generation, entry.layerPaths[layer], layer,
+                                                 entry.width, entry.height});
+                ++inFlight_;
+            }
+        } else {
+            decodeQueue_.push_back(DecodeJob{handle, entry.generation, entry.path, -1, 0, 0});
+            ++inFlight_;
+        }
+    }
+    wake_.notify_all();
+}
+
+bool TextureManager::reload(const std::string& path)
+{
+    bool found = false;
+    for (TextureHandle handle = 0; handle < (TextureHandle)entries_.size(); ++handle)
+    {
+        Entry& entry = entries_[handle];
+        const bool uses = entry.isArray
+                ? std::find(entry.layerPaths.begin(), entry.layerPaths.end(), path) != entry.layerPaths.end()
+                : entry.path == path;
+        if (!uses) {
+            continue;
+        }
+
+        // The live texture stays bound until the new one is complete
+        ++entry.generation;
+        entry.failed = false;
+        if (entry.isArray) {
+            if (entry.building) {
+                glDeleteTextures(1, &entry.building);
+                entry.building = 0;
+            }
+            entry.layersLeft = entry.layers;
+        }
+        queueDecodes(handle);
+        found = true;
+    }
+    return found;
+}
+
+std::vector<std::string> TextureManager::sourcePaths() const
+{
+    std::vector<std::string> paths;
+    for (const Entry& entry : entries_)
+    {
+        if (entry.isArray) {
+            paths.insert(paths.end(), entry.layerPaths.begin(), entry.layerPaths.end());
+        } else {
+            paths.push_back(entry.path);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+    return paths;
+}
+
+unsigned int TextureManager::glTexture(TextureHandle handle) const
+{
+    if (handle >= entries_.size()) {
+        return placeholder_;
+    }
+    if (entries_[handle].texture == 0) {
+        return entries_[handle].isArray ? placeholderArray_ : placeholder_;
+    }
+    return entries_[handle].texture;
+}
+
+bool TextureManager::isReady(TextureHandle handle) const
+{
+    return handle < entries_.size() && entries_[handle].texture != 0;
+}
+
+size_t TextureManager::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inFlight_;
+}
+
+int TextureManager::pump(double budgetMs)
+{
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+
+    int uploaded = 0;
+    for (;;)
+    {
+        DecodedImage image{};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (uploadQueue_.empty()) {
+                break;
+            }
+            image = uploadQueue_.front();
+            uploadQueue_.pop_front();
+        }
+
+        Entry& entry = entries_[image.handle];
+        if (image.generation != entry.generation) {
+            // Superseded by a reload(); the live texture is untouched
+            stbi_image_free(image.pixels);
+        } else {
+            if (image.failed) {
+                entry.failed = true;
+                std::cerr << "Failed to load texture layer " << image.layer << ": "
+                          << entry.layerPaths[image.layer] << std::endl;
+            }
+            if (image.pixels) {
+                if (entry.isArray) {
+                    uploadLayer(image);
+                    uploaded += entry.layersLeft == 0 ? 1 : 0;
+                } else {
+                    upload(image);
+                    ++uploaded;
+                }
+                stbi_image_free(image.pixels);
+            } else if (!image.failed) {
+                entry.failed = true;
+                std::cerr << "Failed to load texture: " << entry.path << std::endl;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --inFlight_;
+        }
+
+        const double spent = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        if (spent >= budgetMs) {
+            break;
+        }
+    }
+    return uploaded;
+}
+
+void TextureManager::workerLoop()
+{
+    for (;;)
+    {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !decodeQueue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(decodeQueue_.front());
+            decodeQueue_.pop_front();
+        }
+
+        DecodedImage image{};
+        image.handle     = job.handle;
+        image.generation = job.generation;
+        image.layer      = job.layer;
+        if (job.layer < 0) {
+            // Always RGBA: grey or grey+alpha sources would otherwise reach
+            // the upload with fewer bytes per pixel than it reads
+            int sourceChannels = 0;
+            image.pixels = stbi_load(job.path.c_str(), &image.width, &image.height, &sourceChannels, 4);
+        } else {
+            // Array layers share one format and size: force RGBA, then
+            // nearest-resample off the GL thread if the source differs
+            int w = 0, h = 0, n = 0;
+            unsigned char* src = stbi_load(job.path.c_str(), &w, &h, &n, 4);
+            image.width    = job.width;
+            image.height   = job.height;
+            // Buffers we allocate here go through stbi_image_free() like
+            // stb's own, which is plain free() (STBI_FREE isn't overridden)
+            if (!src) {
+                // Keep the array complete: a failed layer becomes flat grey
+                image.failed = true;
+                const size_t bytes = (size_t)job.width * job.height * 4;
+                src = (unsigned char*)std::malloc(bytes);
+                std::memset(src, 160, bytes);
+            } else if (w != job.width || h != job.height) {
+                auto* dst = (unsigned char*)std::malloc((size_t)job.width * job.height * 4);
+                for (int y = 0; y < job.height; ++y)
+                {
+                    const int sy = y * h / job.height;
+                    for (int x = 0; x < job.width; ++x)
+                    {
+                        const int sx = x * w / job.width;
+                        std::memcpy(dst + ((size_t)y * job.width + x) * 4, src + ((size_t)sy * w + sx) * 4, 4);
+                    }
+                }
+                stbi_image_free(src);
+                src = dst;
+            }
+            image.pixels = src;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        uploadQueue_.push_back(image);
+    }
+}
+
+// Copies the pixels into the PBO and returns the upload source for
+// glTex(Sub)Image: an offset into the bound PBO, or client memory if
+// mapping failed. Leaves GL_UNPACK_ALIGNMENT at 1 (rows are tightly
+// packed); finishUpload() restores it.
+const void* TextureManager::stage(const DecodedImage& image, size_t size)
+{
+    // Orphan the old storage so we never wait on a previous upload, copy,
+    // then let the driver do the transfer
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadPBO_);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size, nullptr, GL_STREAM_DRAW);
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (dst) {
+        std::memcpy(dst, image.pixels, size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        return nullptr; // offset 0 into the PBO
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return image.pixels;
+}
+
+static void finishUpload()
+{
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureManager::upload(const DecodedImage& image)
+{
+    const size_t size = (size_t)image.width * image.height * 4;
+
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    const void* source = stage(image, size);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
+                 image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, source);
+    finishUpload();
+
+    glGenerateMipmap(GL_TEXTURE_2D);
+    // Wrapping/filtering
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Replaces the previous upload, if this is a reload
+    Entry& entry = entries_[image.handle];
+    if (entry.texture) {
+        glDeleteTextures(1, &entry.texture);
+    }
+    entry.texture = textureID;
+}
+
+void TextureManager::uploadLayer(const DecodedImage& image)
+{
+    Entry& entry = entries_[image.handle];
+    if (entry.building == 0) {
+        glGenTextures(1, &entry.building);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, entry.building);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, entry.width, entry.height, entry.layers,
+                     0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, entry.building);
+
+    const size_t size = (size_t)image.width * image.height * 4;
+    const void* source = stage(image, size);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, image.layer, image.width, image.height, 1,
+                    GL_RGBA, GL_UNSIGNED_BYTE, source);
+    finishUpload();
+
+    if (--entry.layersLeft > 0) {
+        return;
+    }
+
+    // All layers in: build mips once and go live, replacing the previous
+    // upload if this is a reload
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    if (entry.texture) {
+        glDeleteTextures(1, &entry.texture);
+    }
+    entry.texture  = entry.building;
+    entry.building = 0;
+}
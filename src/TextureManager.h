@@ -0,0 +1,127 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_TEXTUREMANAGER_H
+#define TACTICGAME_TEXTUREMANAGER_H
+
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using TextureHandle = std::uint32_t;
+
+// Path-keyed texture cache. Images decode with stb_image on worker threads;
+// the GL thread uploads finished ones through a pixel unpack buffer in
+// pump(), spending at most a time budget per frame. Until a texture is
+// uploaded, glTexture() returns a 1x1 placeholder of the same target
+// (GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY) so callers can bind it unconditionally.
+//
+// reload() re-decodes a texture the same way while the old one stays bound;
+// pump() swaps the new one in once it's complete, so a frame never sees a
+// half-uploaded texture.
+class TextureManager
+{
+public:
+    explicit TextureManager(int workerThreads = 2);
+    ~TextureManager();
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    // Cached handle for `path`; the first call queues the decode
+    TextureHandle load(const std::string& path);
+
+    // GL_TEXTURE_2D_ARRAY with one layer per path, every layer decoded to
+    // RGBA and resized to width x height. Cached by the joined path list.
+    // Goes live once all layers are uploaded.
+    TextureHandle loadArray(const std::vector<std::string>& layerPaths, int width, int height);
+
+    // Re-decodes every texture using the file `path` (hot reload); false if
+    // none does. Loads of the same texture still in flight are superseded.
+    bool reload(const std::string& path);
+    // Every source file, for a watcher
+    std::vector<std::string> sourcePaths() const;
+
+    unsigned int glTexture(TextureHandle handle) const;
+    bool isReady(TextureHandle handle) const;
+    const std::string& path(TextureHandle handle) const { return entries_[handle].path; }
+
+    // Upload decoded images until `budgetMs` is spent (at least one per call).
+    // GL thread only; returns how many textures went live.
+    int pump(double budgetMs = 2.0);
+
+    // Decodes queued or waiting for upload
+    size_t pendingCount() const;
+
+private:
+    struct Entry
+    {
+        std::string path;
+        unsigned int texture = 0; // 0 until uploaded
+        bool failed = false;
+        std::uint32_t generation = 0; // bumped by reload(); older decodes are dropped
+
+        // Array textures only
+        bool isArray = false;
+        int width = 0;
+        int height = 0;
+        int layers = 0;
+        int layersLeft = 0;
+        unsigned int building = 0; // storage filled layer by layer
+        std::vector<std::string> layerPaths;
+    };
+
+    struct DecodeJob
+    {
+        TextureHandle handle;
+        std::uint32_t generation;
+        std::string path;
+        int layer;  // -1 for a plain 2D texture
+        int width;  // forced size for array layers, else 0
+        int height;
+    };
+
+    struct DecodedImage
+    {
+        TextureHandle handle;
+        std::uint32_t generation;
+        int layer;
+        int width;
+        int height;
+        unsigned char* pixels; // owned, stbi_image_free (or null on failure)
+        bool failed;           // decode failed (array layers still get grey pixels)
+    };
+
+    // GL-thread state
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, TextureHandle> byPath_;
+    unsigned int placeholder_;
+    unsigned int placeholderArray_;
+    unsigned int uploadPBO_;
+
+    // Shared with workers
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<DecodeJob> decodeQueue_;
+    std::deque<DecodedImage> uploadQueue_;
+    size_t inFlight_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+
+    // Queues the decodes for entry `handle`'s current generation
+    void queueDecodes(TextureHandle handle);
+    void workerLoop();
+    void upload(const DecodedImage& image);
+    void uploadLayer(const DecodedImage& image);
+    const void* stage(const DecodedImage& image, size_t size);
+};
+
+
+#endif //TACTICGAME_TEXTUREMANAGER_H
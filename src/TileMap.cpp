@@ -0,0 +1,62 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "TileMap.h"
+
+TileMap::TileMap(int width, int depth)
+        : width_(width),
+          depth_(depth),
+          chunksX_((width + kChunkSize - 1) / kChunkSize),
+          chunksZ_((depth + kChunkSize - 1) / kChunkSize),
+          heights_((size_t)width * depth, 1.0f),
+          types_((size_t)width * depth, 0),
+          chunkRevisions_((size_t)chunksX_ * chunksZ_, 1),
+          revision_(1)
+{
+}
+
+TileMap::TileMap(int width, int depth, const float* heights, const std::uint8_t* types)
+        : width_(width),
+          depth_(depth),
+          chunksX_((width + kChunkSize - 1) / kChunkSize),
+          chunksZ_((depth + kChunkSize - 1) / kChunkSize),
+          heights_(heights, heights + (size_t)width * depth),
+          types_(types, types + (size_t)width * depth),
+          chunkRevisions_((size_t)chunksX_ * chunksZ_, 1),
+          revision_(1)
+{
+}
+
+void TileMap::setTile(int i, int j, float height, int type)
+{
+    if (!inBounds(i, j)) {
+        return;
+    }
+
+    size_t k = index(i, j);
+    if (heights_[k] == height && types_[k] == (std::uint8_t)type) {
+        return;
+    }
+    heights_[k] = height;
+    types_[k]   = (std::uint8_t)type;
+
+    // Side faces of the four neighbours depend on this tile's height, and
+    // they may live in an adjacent chunk
+    touchChunkOf(i, j);
+    touchChunkOf(i - 1, j);
+    touchChunkOf(i + 1, j);
+    touchChunkOf(i, j - 1);
+    touchChunkOf(i, j + 1);
+    ++revision_;
+}
+
+void TileMap::touchChunkOf(int i, int j)
+{
+    if (!inBounds(i, j)) {
+        return;
+    }
+    // Tag with the revision this edit produces; neighbours sharing a chunk
+    // just write the same value again
+    chunkRevisions_[(j / kChunkSize) * chunksX_ + i / kChunkSize] = revision_ + 1;
+}
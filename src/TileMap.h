@@ -0,0 +1,84 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_TILEMAP_H
+#define TACTICGAME_TILEMAP_H
+
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Tiles per chunk side; chunks are the unit of meshing and invalidation
+constexpr int kChunkSize = 16;
+
+// Board description: a column of height `height` per tile (0 = no tile).
+// A height of 1 matches the original unit cube spanning y = -0.5 .. 0.5.
+//
+// Every edit bumps a revision counter on the chunks whose geometry can change,
+// so consumers (chunk meshes, caches) compare revisions instead of sharing a
+// dirty flag that only one of them is allowed to clear.
+class TileMap
+{
+public:
+    TileMap(int width, int depth);
+    // Board with the given tiles (TileMap layout), e.g. straight from a MapFile
+    TileMap(int width, int depth, const float* heights, const std::uint8_t* types);
+
+    int width() const { return width_; }
+    int depth() const { return depth_; }
+
+    bool inBounds(int i, int j) const { return i >= 0 && j >= 0 && i < width_ && j < depth_; }
+    bool hasTile(int i, int j) const { return inBounds(i, j) && heights_[index(i, j)] > 0.0f; }
+
+    float height(int i, int j) const { return inBounds(i, j) ? heights_[index(i, j)] : 0.0f; }
+    int type(int i, int j) const { return inBounds(i, j) ? types_[index(i, j)] : 0; }
+
+    void setTile(int i, int j, float height, int type);
+
+    // World-space centre of the tile column footprint (y = 0)
+    glm::vec3 tileCenter(int i, int j) const
+    {
+        return glm::vec3(i - width_ / 2.0f, 0.0f, j - depth_ / 2.0f);
+    }
+    // Tile whose footprint contains the world XZ position (may be out of bounds)
+    glm::ivec2 tileAt(const glm::vec3& world) const
+    {
+        return glm::ivec2((int)std::floor(world.x + width_ / 2.0f + 0.5f),
+                          (int)std::floor(world.z + depth_ / 2.0f + 0.5f));
+    }
+    // y of the walkable top surface
+    float topY(int i, int j) const { return height(i, j) - 0.5f; }
+
+    int chunksX() const { return chunksX_; }
+    int chunksZ() const { return chunksZ_; }
+    int chunkCount() const { return chunksX_ * chunksZ_; }
+
+    std::uint32_t chunkRevision(int cx, int cz) const { return chunkRevisions_[cz * chunksX_ + cx]; }
+    // Bumped on any edit; cheap "did anything change" test
+    std::uint32_t revision() const { return revision_; }
+
+    const std::vector<float>& heights() const { return heights_; }
+    const std::vector<std::uint8_t>& types() const { return types_; }
+
+private:
+    int width_;
+    int depth_;
+    int chunksX_;
+    int chunksZ_;
+
+    // Row-major by i (index = i * depth + j), matching the original grid loop
+    std::vector<float> heights_;
+    std::vector<std::uint8_t> types_;
+
+    std::vector<std::uint32_t> chunkRevisions_;
+    std::uint32_t revision_;
+
+    size_t index(int i, int j) const { return (size_t)i * depth_ + j; }
+    void touchChunkOf(int i, int j);
+};
+
+
+#endif //TACTICGAME_TILEMAP_H
@@ -0,0 +1,122 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "UnitStore.h"
+
+UnitHandle UnitStore::create(const UnitDesc& desc)
+{
+    std::uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = (std::uint32_t)slotToDense_.size();
+        slotToDense_.push_back(0);
+        generations_.push_back(0);
+    }
+
+    const std::uint32_t dense = (std::uint32_t)positions_.size();
+    slotToDense_[slot] = dense;
+
+    positions_.push_back(desc.position);
+    prevPositions_.push_back(desc.position);
+    targetTiles_.push_back(kNoTarget);
+    waypoints_.push_back(kNoTarget);
+    moveSpeeds_.push_back(desc.moveSpeed);
+    scales_.push_back(desc.scale);
+    facings_.push_back(desc.facing);
+    hp_.push_back(desc.hp);
+    teams_.push_back(desc.team);
+    visionRadii_.push_back(desc.vision);
+    denseToSlot_.push_back(slot);
+
+    return UnitHandle{slot, generations_[slot]};
+}
+
+void UnitStore::destroy(UnitHandle handle)
+{
+    if (!alive(handle)) {
+        return;
+    }
+
+    // Swap-remove: move the last unit into the hole
+    const std::uint32_t dense = slotToDense_[handle.slot];
+    const std::uint32_t last  = (std::uint32_t)positions_.size() - 1;
+    if (dense != last) {
+        positions_[dense]     = positions_[last];
+        prevPositions_[dense] = prevPositions_[last];
+        targetTiles_[dense]   = targetTiles_[last];
+        waypoints_[dense]     = waypoints_[last];
+        moveSpeeds_[dense]    = moveSpeeds_[last];
+        scales_[dense]        = scales_[last];
+        facings_[dense]       = facings_[last];
+        hp_[dense]            = hp_[last];
+        teams_[dense]         = teams_[last];
+        visionRadii_[dense]   = visionRadii_[last];
+        denseToSlot_[dense]   = denseToSlot_[last];
+        slotToDense_[denseToSlot_[dense]] = dense;
+    }
+    positions_.pop_back();
+    prevPositions_.pop_back();
+    targetTiles_.pop_back();
+    waypoints_.pop_back();
+    moveSpeeds_.pop_back();
+    scales_.pop_back();
+    facings_.pop_back();
+    hp_.pop_back();
+    teams_.pop_back();
+    visionRadii_.pop_back();
+    denseToSlot_.pop_back();
+
+    ++generations_[handle.slot];
+    freeSlots_.push_back(handle.slot);
+}
+
+void UnitStore::clear()
+{
+    for (std::uint32_t slot : denseToSlot_)
+    {
+        ++generations_[slot];
+        freeSlots_.push_back(slot);
+    }
+    positions_.clear();
+    prevPositions_.clear();
+    targetTiles_.clear();
+    waypoints_.clear();
+    moveSpeeds_.clear();
+    scales_.clear();
+    facings_.clear();
+    hp_.clear();
+    teams_.clear();
+    visionRadii_.clear();
+    denseToSlot_.clear();
+}
+
+bool UnitStore::alive(UnitHandle handle) const
+{
+    return handle.slot < generations_.size()
+           && generations_[handle.slot] == handle.generation
+           && slotToDense_[handle.slot] < denseToSlot_.size()
+           && denseToSlot_[slotToDense_[handle.slot]] == handle.slot;
+}
+
+void UnitStore::restoreSlots(const std::uint32_t* denseToSlot, size_t count,
+                             const std::uint32_t* generations, size_t slotCount,
+                             const std::uint32_t* freeSlots, size_t freeCount)
+{
+    denseToSlot_.assign(denseToSlot, denseToSlot + count);
+    generations_.assign(generations, generations + slotCount);
+    freeSlots_.assign(freeSlots, freeSlots + freeCount);
+    // Dead slots' entries are never read (alive() checks the round trip)
+    slotToDense_.assign(slotCount, 0);
+    for (size_t dense = 0; dense < count; ++dense) {
+        slotToDense_[denseToSlot_[dense]] = (std::uint32_t)dense;
+    }
+}
+
+UnitHandle UnitStore::handleAt(std::uint32_t index) const
+{
+    const std::uint32_t slot = denseToSlot_[index];
+    return UnitHandle{slot, generations_[slot]};
+}
@@ -0,0 +1,109 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_UNITSTORE_H
+#define TACTICGAME_UNITSTORE_H
+
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Stable reference to a unit. Survives other units being destroyed; goes
+// stale (alive() == false) once its own unit is destroyed.
+struct UnitHandle
+{
+    std::uint32_t slot = 0xFFFFFFFFu;
+    std::uint32_t generation = 0;
+
+    bool operator==(const UnitHandle& o) const { return slot == o.slot && generation == o.generation; }
+    bool operator!=(const UnitHandle& o) const { return !(*this == o); }
+};
+
+struct UnitDesc
+{
+    glm::vec3 position{0.0f};
+    std::uint8_t team = 0;
+    std::int16_t hp = 10;
+    float moveSpeed = 1.2f; // world units per second
+    float scale = 1.0f;
+    glm::vec2 facing{0.0f, 1.0f}; // unit XZ direction
+    std::uint8_t vision = 5;      // sight radius in tiles
+};
+
+// No target tile
+inline const glm::ivec2 kNoTarget{-1, -1};
+
+// Structure-of-arrays unit storage. Components live in parallel dense
+// arrays (index 0 .. size()-1) so per-tick systems are straight loops;
+// destroy() swap-removes to keep them packed. Handles go through a slot
+// table, so dense indices may change but handles don't.
+class UnitStore
+{
+public:
+    UnitHandle create(const UnitDesc& desc);
+    void destroy(UnitHandle handle);
+    void clear();
+
+    bool alive(UnitHandle handle) const;
+    // Dense index for a live handle (check alive() first)
+    std::uint32_t indexOf(UnitHandle handle) const { return slotToDense_[handle.slot]; }
+    UnitHandle handleAt(std::uint32_t index) const;
+
+    size_t size() const { return positions_.size(); }
+
+    // Dense component arrays
+    std::vector<glm::vec3>& positions() { return positions_; }
+    std::vector<glm::vec3>& prevPositions() { return prevPositions_; }
+    std::vector<glm::ivec2>& targetTiles() { return targetTiles_; }
+    std::vector<glm::ivec2>& waypoints() { return waypoints_; }
+    std::vector<float>& moveSpeeds() { return moveSpeeds_; }
+    std::vector<float>& scales() { return scales_; }
+    std::vector<glm::vec2>& facings() { return facings_; }
+    std::vector<std::int16_t>& hp() { return hp_; }
+    std::vector<std::uint8_t>& teams() { return teams_; }
+    std::vector<std::uint8_t>& visionRadii() { return visionRadii_; }
+
+    const std::vector<glm::vec3>& positions() const { return positions_; }
+    const std::vector<glm::vec3>& prevPositions() const { return prevPositions_; }
+    const std::vector<glm::ivec2>& targetTiles() const { return targetTiles_; }
+    const std::vector<glm::ivec2>& waypoints() const { return waypoints_; }
+    const std::vector<float>& moveSpeeds() const { return moveSpeeds_; }
+    const std::vector<float>& scales() const { return scales_; }
+    const std::vector<glm::vec2>& facings() const { return facings_; }
+    const std::vector<std::int16_t>& hp() const { return hp_; }
+    const std::vector<std::uint8_t>& teams() const { return teams_; }
+    const std::vector<std::uint8_t>& visionRadii() const { return visionRadii_; }
+
+    // Slot table, for snapshots
+    const std::vector<std::uint32_t>& denseToSlot() const { return denseToSlot_; }
+    const std::vector<std::uint32_t>& generations() const { return generations_; }
+    const std::vector<std::uint32_t>& freeSlots() const { return freeSlots_; }
+    // Replaces the slot table with a snapshot's. The component arrays must
+    // already hold `count` units; slots are validated by the caller.
+    void restoreSlots(const std::uint32_t* denseToSlot, size_t count,
+                      const std::uint32_t* generations, size_t slotCount,
+                      const std::uint32_t* freeSlots, size_t freeCount);
+
+private:
+    std::vector<glm::vec3> positions_;
+    std::vector<glm::vec3> prevPositions_;
+    std::vector<glm::ivec2> targetTiles_;
+    std::vector<glm::ivec2> waypoints_; // tile currently being stepped onto
+    std::vector<float> moveSpeeds_;
+    std::vector<float> scales_;
+    std::vector<glm::vec2> facings_;
+    std::vector<std::int16_t> hp_;
+    std::vector<std::uint8_t> teams_;
+    std::vector<std::uint8_t> visionRadii_;
+    std::vector<std::uint32_t> denseToSlot_;
+
+    // Slot table
+    std::vector<std::uint32_t> slotToDense_;
+    std::vector<std::uint32_t> generations_;
+    std::vector<std::uint32_t> freeSlots_;
+};
+
+
+#endif //TACTICGAME_UNITSTORE_H
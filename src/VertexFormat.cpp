@@ -0,0 +1,115 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#include "VertexFormat.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static GLenum glType(VertexAttribType type)
+{
+    switch (type) {
+        case VertexAttribType::Float:         return GL_FLOAT;
+        case VertexAttribType::HalfFloat:     return GL_HALF_FLOAT;
+        case VertexAttribType::UInt16:        return GL_UNSIGNED_SHORT;
+        case VertexAttribType::Int16:         return GL_SHORT;
+        case VertexAttribType::Int2_10_10_10: return GL_INT_2_10_10_10_REV;
+    }
+    return GL_FLOAT;
+}
+
+void VertexFormat::apply(std::size_t baseOffset) const
+{
+    for (const VertexAttribute& attribute : attributes) {
+        glVertexAttribPointer(attribute.location, attribute.components, glType(attribute.type),
+                              attribute.normalized ? GL_TRUE : GL_FALSE, (GLsizei)stride,
+                              (void*)(baseOffset + attribute.offset));
+        glEnableVertexAttribArray(attribute.location);
+    }
+}
+
+const VertexFormat& chunkVertexFormat()
+{
+    static const VertexFormat format{
+            sizeof(ChunkVertex),
+            {
+                    {0, 3, VertexAttribType::UInt16,        false, offsetof(ChunkVertex, position)},
+                    {1, 2, VertexAttribType::HalfFloat,     false, offsetof(ChunkVertex, uv)},
+                    {2, 4, VertexAttribType::Int2_10_10_10, true,  offsetof(ChunkVertex, normal)},
+                    {4, 1, VertexAttribType::UInt16,        false, offsetof(ChunkVertex, layer)},
+            }
+    };
+    return format;
+}
+
+const VertexFormat& meshVertexFormat()
+{
+    static const VertexFormat format{
+            sizeof(MeshVertex),
+            {
+                    {0, 3, VertexAttribType::HalfFloat,     false, offsetof(MeshVertex, position)},
+                    {1, 2, VertexAttribType::HalfFloat,     false, offsetof(MeshVertex, uv)},
+                    {2, 4, VertexAttribType::Int2_10_10_10, true,  offsetof(MeshVertex, normal)},
+            }
+    };
+    return format;
+}
+
+MeshVertex packMeshVertex(const glm::vec3& position, const glm::vec2& uv, const glm::vec3& normal)
+{
+    MeshVertex v;
+    v.position[0] = packHalf(position.x);
+    v.position[1] = packHalf(position.y);
+    v.position[2] = packHalf(position.z);
+    v.position[3] = packHalf(1.0f);
+    v.normal      = packNormal(normal);
+    v.uv[0]       = packHalf(uv.x);
+    v.uv[1]       = packHalf(uv.y);
+    return v;
+}
+
+std::uint16_t packHalf(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::uint32_t rawExponent = (bits >> 23) & 0xFFu;
+    std::uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (rawExponent == 0xFFu) {
+        return (std::uint16_t)(sign | 0x7C00u | (mantissa ? 0x200u : 0u)); // inf / nan
+    }
+    const int exponent = (int)rawExponent - 127 + 15;
+    if (exponent >= 31) {
+        return (std::uint16_t)(sign | 0x7C00u); // overflow to inf
+    }
+
+    // Round to nearest even on the bits shifted out
+    auto round = [](std::uint32_t value, std::uint32_t dropped, std::uint32_t halfway) {
+        return value + (dropped > halfway || (dropped == halfway && (value & 1u)) ? 1u : 0u);
+    };
+    if (exponent <= 0) {
+        // Subnormal half (or zero)
+        if (exponent < -10) {
+            return (std::uint16_t)sign;
+        }
+        mantissa |= 0x800000u;
+        const int shift = 14 - exponent;
+        const std::uint32_t half = round(mantissa >> shift, mantissa & ((1u << shift) - 1u), 1u << (shift - 1));
+        return (std::uint16_t)(sign | half);
+    }
+    // A carry out of the mantissa bumps the exponent, which is still correct
+    const std::uint32_t half = round(((std::uint32_t)exponent << 10) | (mantissa >> 13), mantissa & 0x1FFFu, 0x1000u);
+    return (std::uint16_t)(sign | half);
+}
+
+std::uint32_t packNormal(const glm::vec3& normal)
+{
+    auto snorm10 = [](float v) {
+        const int q = (int)std::lround(std::clamp(v, -1.0f, 1.0f) * 511.0f);
+        return (std::uint32_t)q & 0x3FFu;
+    };
+    return snorm10(normal.x) | (snorm10(normal.y) << 10) | (snorm10(normal.z) << 20);
+}
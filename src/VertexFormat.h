@@ -0,0 +1,93 @@
+//
+// Created by User on 14/10/2026.
+//
+
+#ifndef TACTICGAME_VERTEXFORMAT_H
+#define TACTICGAME_VERTEXFORMAT_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Component encodings a vertex attribute can use; everything reaches the
+// shader as float
+enum class VertexAttribType : std::uint8_t
+{
+    Float,
+    HalfFloat,
+    UInt16,         // integer value as float (normalized: / 65535)
+    Int16,          // integer value as float (normalized: / 32767)
+    Int2_10_10_10,  // GL_INT_2_10_10_10_REV, always 4 components
+};
+
+struct VertexAttribute
+{
+    unsigned int location;
+    int components;
+    VertexAttribType type;
+    bool normalized;
+    std::uint32_t offset;
+};
+
+// Interleaved vertex layout, described once and applied to any VAO
+struct VertexFormat
+{
+    std::uint32_t stride;
+    std::vector<VertexAttribute> attributes;
+
+    // Points and enables every attribute at the bound GL_ARRAY_BUFFER,
+    // starting `baseOffset` bytes in. Expects the target VAO bound.
+    void apply(std::size_t baseOffset = 0) const;
+};
+
+// --------------------------------------------------------------------------------
+// Baked terrain (MapChunks): 16 bytes, was 36.
+//   position  uint16 x3, fixed point in kChunkPositionStep units from the
+//             chunk origin (dequantized by the draw's model matrix), so
+//             vertices on a chunk seam quantize identically on both sides
+//   layer     uint16 material layer (location 4)
+//   normal    2_10_10_10 snorm
+//   uv        half x2 (side faces repeat the texture, so v can exceed 1)
+// --------------------------------------------------------------------------------
+constexpr float kChunkPositionStep = 1.0f / 256.0f;
+// Tallest column the encoding holds (uint16 steps); MapCompiler rejects more
+constexpr float kChunkMaxHeight = 255.0f;
+
+struct ChunkVertex
+{
+    std::uint16_t position[3];
+    std::uint16_t layer;
+    std::uint32_t normal;
+    std::uint16_t uv[2];
+};
+static_assert(sizeof(ChunkVertex) == 16, "ChunkVertex is uploaded as-is");
+
+const VertexFormat& chunkVertexFormat();
+
+// --------------------------------------------------------------------------------
+// Procedural meshes (unit spheres, the tile cube): 16 bytes, was 32.
+//   position  half x4 (w = 1, unread), fine for the sub-unit sizes used
+//   normal    2_10_10_10 snorm
+//   uv        half x2
+// --------------------------------------------------------------------------------
+struct MeshVertex
+{
+    std::uint16_t position[4];
+    std::uint32_t normal;
+    std::uint16_t uv[2];
+};
+static_assert(sizeof(MeshVertex) == 16, "MeshVertex is uploaded as-is");
+
+const VertexFormat& meshVertexFormat();
+
+MeshVertex packMeshVertex(const glm::vec3& position, const glm::vec2& uv, const glm::vec3& normal);
+
+// Encoders
+std::uint16_t packHalf(float value);
+// Unit vector to GL_INT_2_10_10_10_REV (w = 0)
+std::uint32_t packNormal(const glm::vec3& normal);
+
+
+#endif //TACTICGAME_VERTEXFORMAT_H
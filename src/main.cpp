@@ -5,145 +5,127 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <vector>
+#include <memory>
 #include <cmath>
-
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+
+#include "Camera.h"
+#include "SceneRenderer.h"
+#include "RenderThread.h"
+#include "TileMap.h"
+#include "GameClock.h"
+#include "Simulation.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "AiEvaluator.h"
+#include "FogOfWar.h"
+#include "FramePacer.h"
+#include "MapFile.h"
+#include "Picking.h"
+#include "Replay.h"
+#include "Resources.h"
+#include "Snapshot.h"
 
 // --------------------------------------------------------------------------------
 // Global variables
 // --------------------------------------------------------------------------------
 
-// -- Existing: isometric camera position --
-glm::vec3 cameraPos(2.0f, 2.0f, 2.0f);
+// Isometric and free camera; C switches, the scroll wheel zooms
+Camera camera;
 
-// -- Player position (sphere) --
-glm::vec3 playerPos(0.0f);
-float playerMoveSpeed = 0.02f;  // Movement speed for the sphere
+// G toggles the terrain path: baked chunk meshes or one instanced cube per tile
+bool gPressed = false;
+bool chunkedTerrain = true;
 
-// -- Zoom for orthographic isometric camera --
-float zoomLevel = 10.0f;
+// L cycles the shadow quality: off, hard, 3x3 PCF, 5x5 PCF
+bool lPressed = false;
+ShadowQuality shadowQuality = ShadowQuality::Pcf3x3;
 
-// NEW: free‐camera variables
-bool isFreeCamera = false;
-bool cPressed     = false;  // used to detect toggling
+// Profiler: P dumps stats to the log, T starts/stops a Chrome trace capture
+bool pPressed = false;
+bool tPressed = false;
 
-// For free‐camera motion & orientation
-glm::vec3 freeCamPos   = glm::vec3(2.0f, 2.0f,  2.0f); // you can pick your own initial
-glm::vec3 cameraFront  = glm::vec3(0.0f, 0.0f, -1.0f);
-glm::vec3 cameraUp     = glm::vec3(0.0f, 1.0f,  0.0f);
+// Enter ends the player's turn; the AI team then plans and moves
+bool enterPressed = false;
 
-float yaw   = -90.0f; // so that initial front is along -Z
-float pitch = 0.0f;
+// C toggles the free camera
+bool cPressed = false;
 
-// Mouse tracking
-float lastX = 400.0f; // center of window
-float lastY = 300.0f;
-bool firstMouse = true;
+bool isFreeCamera()
+{
+    return camera.getMode() == CameraMode::Free;
+}
 
-// Movement speed for free camera
-float freeCamSpeed = 0.05f;
-float mouseSensitivity = 0.1f;
+// Set when the window needs repainting (exposed, resized) though nothing
+// in the scene changed
+bool windowDamaged = false;
+
+// What the last drawn frame showed; a frame that matches it is skipped
+struct PresentedFrame
+{
+    std::uint32_t cameraRevision = 0;
+    std::vector<glm::vec3> unitPositions;
+    glm::ivec2 highlightTile{-1, -1};
+    bool chunkedTerrain = true;
+    ShadowQuality shadowQuality = ShadowQuality::Pcf3x3;
+    int viewportWidth = 0;
+    int viewportHeight = 0;
+    int swapInterval = 1;
+    bool valid = false;
+
+    // True if `frame` shows anything different; remembers it either way
+    bool update(const RenderFrame& frame, std::uint32_t revision)
+    {
+        const bool changed = !valid
+                             || revision != cameraRevision
+                             || frame.units.positions != unitPositions
+                             || frame.highlightTile != highlightTile
+                             || frame.chunkedTerrain != chunkedTerrain
+                             || frame.shadowQuality != shadowQuality
+                             || frame.viewportWidth != viewportWidth
+                             || frame.viewportHeight != viewportHeight
+                             || frame.swapInterval != swapInterval
+                             || !frame.fog.empty()
+                             || !frame.tileEdits.empty();
+        if (changed) {
+            cameraRevision = revision;
+            unitPositions  = frame.units.positions;
+            highlightTile  = frame.highlightTile;
+            chunkedTerrain = frame.chunkedTerrain;
+            shadowQuality  = frame.shadowQuality;
+            viewportWidth  = frame.viewportWidth;
+            viewportHeight = frame.viewportHeight;
+            swapInterval   = frame.swapInterval;
+            valid = true;
+        }
+        return changed;
+    }
+};
 
 // --------------------------------------------------------------------------------
 // Forward declarations
 // --------------------------------------------------------------------------------
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
-
-unsigned int createShaderProgram(const char* vertexSrc, const char* fragmentSrc);
-unsigned int loadTexture(const char* path);
-
-// --------------------------------------------------------------------------------
-// Vertex Shader
-// --------------------------------------------------------------------------------
-const char* vertexShaderSource = R"(
-#version 330 core
-layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec2 aTexCoord;
-layout(location = 2) in vec3 aNormal;
-
-out vec2 TexCoord;
-out vec3 Normal;
-out vec3 FragPos;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
-    TexCoord = aTexCoord;
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-}
-)";
+void refresh_callback(GLFWwindow* window);
 
 // --------------------------------------------------------------------------------
-// Fragment Shader (with "sky" lighting + optional solid color)
+// Scroll callback for zoom
 // --------------------------------------------------------------------------------
-const char* fragmentShaderSource = R"(
-#version 330 core
-out vec4 FragColor;
-
-in vec2 TexCoord;
-in vec3 Normal;
-in vec3 FragPos;
-
-uniform sampler2D texture1;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform vec3 viewPos;
-
-// "Sky" color and strength
-uniform vec3 skyColor;
-uniform float skyStrength;
-
-// If true, ignore texture and use solidColor
-uniform bool useSolidColor;
-uniform vec3 solidColor;
-
-void main()
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
-    // Ambient lighting
-    float ambientStrength = 0.2;
-    vec3 ambient = ambientStrength * lightColor;
-    ambient += skyStrength * skyColor;
-
-    // Diffuse lighting
-    vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
-
-    // Specular lighting
-    float specularStrength = 0.5;
-    vec3 viewDir = normalize(viewPos - FragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;
-
-    // Combine them
-    vec3 lighting = ambient + diffuse + specular;
-
-    if(useSolidColor) {
-        FragColor = vec4(lighting * solidColor, 1.0);
-    } else {
-        // Use a texture
-        vec3 texColor = texture(texture1, TexCoord).rgb;
-        FragColor = vec4(lighting * texColor, 1.0);
-    }
+    camera.zoomBy((float)yoffset);
 }
-)";
 
 // --------------------------------------------------------------------------------
-// Scroll callback for zoom
+// Refresh callback: the window's contents were lost (uncovered, resized)
 // --------------------------------------------------------------------------------
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+void refresh_callback(GLFWwindow* window)
 {
-    zoomLevel -= (float)yoffset * 0.1f;
-    if (zoomLevel < 0.1f) zoomLevel = 0.1f;
+    windowDamaged = true;
 }
 
 // --------------------------------------------------------------------------------
@@ -151,197 +133,38 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 // --------------------------------------------------------------------------------
 void mouse_callback(GLFWwindow* window, double xpos, double ypos)
 {
-    if(!isFreeCamera) {
-        // If we're NOT in free‐camera mode, do nothing with the mouse
-        return;
-    }
-
-    if (firstMouse) {
-        lastX = (float)xpos;
-        lastY = (float)ypos;
-        firstMouse = false;
-    }
-
-    float xoffset = (float)xpos - lastX;
-    float yoffset = lastY - (float)ypos;  // reversed: screen coords go top->down
-    lastX = (float)xpos;
-    lastY = (float)ypos;
-
-    xoffset *= mouseSensitivity;
-    yoffset *= mouseSensitivity;
-
-    yaw   += xoffset;
-    pitch += yoffset;
-
-    // Constrain pitch
-    if (pitch > 89.0f)  pitch = 89.0f;
-    if (pitch < -89.0f) pitch = -89.0f;
-
-    // Recompute cameraFront from yaw/pitch
-    glm::vec3 direction;
-    direction.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
-    direction.y = sin(glm::radians(pitch));
-    direction.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-    cameraFront = glm::normalize(direction);
-}
-
-// --------------------------------------------------------------------------------
-// Helper: Compile & link shaders
-// --------------------------------------------------------------------------------
-unsigned int compileShader(const char* source, GLenum type) {
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-    int success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Shader compilation error: " << infoLog << std::endl;
-    }
-    return shader;
-}
-
-unsigned int createShaderProgram(const char* vertexSrc, const char* fragmentSrc) {
-    unsigned int vs = compileShader(vertexSrc, GL_VERTEX_SHADER);
-    unsigned int fs = compileShader(fragmentSrc, GL_FRAGMENT_SHADER);
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-
-    int success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetProgramInfoLog(program, 512, nullptr, infoLog);
-        std::cerr << "Shader program linking error: " << infoLog << std::endl;
-    }
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    return program;
-}
-
-// --------------------------------------------------------------------------------
-// Load texture from file
-// --------------------------------------------------------------------------------
-unsigned int loadTexture(const char* path) {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-    if (data) {
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format,
-                     width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        // Wrapping/filtering
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    } else {
-        std::cerr << "Failed to load texture: " << path << std::endl;
-    }
-    return textureID;
+    // Ignored unless in free-camera mode
+    camera.handleMouse(xpos, ypos);
 }
 
-// --------------------------------------------------------------------------------
-// Generate a UV-sphere for the "player" object
-// --------------------------------------------------------------------------------
-void createSphereVAO(float radius, int sectorCount, int stackCount,
-                     unsigned int &VAO, unsigned int &VBO, unsigned int &EBO)
+// Built-in 10x10 skirmish, used when no compiled map is found; mirrors
+// resources/maps/skirmish.json
+TileMap defaultBoard(std::vector<MapSpawn>& spawns)
 {
-    std::vector<float> vertices;
-    std::vector<unsigned int> indices;
-
-    float lengthInv = 1.0f / radius;
-
-    for(int i = 0; i <= stackCount; ++i) {
-        float stackAngle =  (float)M_PI/2.0f - (float)i * (float)M_PI / (float)stackCount;
-        float xy = radius * cosf(stackAngle);
-        float y  = radius * sinf(stackAngle);
-
-        for(int j = 0; j <= sectorCount; ++j) {
-            float sectorAngle = (float)j * 2.0f * (float)M_PI / (float)sectorCount;
-
-            float x = xy * cosf(sectorAngle);
-            float z = xy * sinf(sectorAngle);
-
-            float nx = x * lengthInv;
-            float ny = y * lengthInv;
-            float nz = z * lengthInv;
-
-            float u = (float)j / (float)sectorCount;
-            float v = (float)i / (float)stackCount;
+    const int gridSize = 10;
 
-            vertices.push_back(x);
-            vertices.push_back(y);
-            vertices.push_back(z);
-            vertices.push_back(u);
-            vertices.push_back(v);
-            vertices.push_back(nx);
-            vertices.push_back(ny);
-            vertices.push_back(nz);
-        }
+    // Board data; every tile starts as a unit-height cube of type 0
+    TileMap tileMap(gridSize, gridSize);
+    // A road across the middle and a raised patch in one corner, so the
+    // mixed-material path is visible
+    for (int i = 0; i < gridSize; ++i) {
+        tileMap.setTile(i, gridSize / 2, 1.0f, 1);
     }
-
-    for(int i = 0; i < stackCount; ++i) {
-        int k1 = i * (sectorCount + 1);
-        int k2 = k1 + sectorCount + 1;
-        for(int j = 0; j < sectorCount; ++j, ++k1, ++k2) {
-            if(i != 0) {
-                indices.push_back(k1);
-                indices.push_back(k2);
-                indices.push_back(k1 + 1);
-            }
-            if(i != (stackCount-1)) {
-                indices.push_back(k1 + 1);
-                indices.push_back(k2);
-                indices.push_back(k2 + 1);
-            }
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            tileMap.setTile(gridSize - 1 - i, gridSize - 1 - j, 1.5f, 2);
         }
     }
 
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
-                 vertices.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
-                 indices.data(), GL_STATIC_DRAW);
-
-    // Positions
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
-                          (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Tex coords
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
-                          (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Normals
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
-                          (void*)(5 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    glBindVertexArray(0);
+    // The player, then a small opposing squad patrolling toward the road
+    spawns.push_back({3, 2, -1, -1, 1.2f, 1.0f, 10, 0, 5});
+    for (int n = 0; n < 3; ++n) {
+        spawns.push_back({2 + 2 * n, 1, 2 + 2 * n, gridSize / 2, 0.6f, 1.0f, 10, 1, 5});
+    }
+    return tileMap;
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Init GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to init GLFW\n";
@@ -361,273 +184,357 @@ int main() {
         return -1;
     }
 
-    glViewport(0, 0, 800, 600);
-    glEnable(GL_DEPTH_TEST);
-
-    // Background
-    glClearColor(0.7f, 0.7f, 0.7f, 1.0f);
+    // GL calls happen on the render thread from here on
+    glfwMakeContextCurrent(nullptr);
 
     // Scroll for zoom
     glfwSetScrollCallback(window, scroll_callback);
 
-    // NEW: mouse callback + capture
+    // NEW: mouse callback; the cursor is only captured in free-camera mode,
+    // otherwise it points at tiles and units
     glfwSetCursorPosCallback(window, mouse_callback);
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-
-    // Build shader program
-    unsigned int shaderProgram = createShaderProgram(vertexShaderSource, fragmentShaderSource);
-
-    // --------------------------------------------------------------------------------
-    // Create the cubes (grid)
-    // --------------------------------------------------------------------------------
-    float cubeVertices[] = {
-            // positions          // tex coords  // normals
-            // Back face
-            -0.5f, -0.5f, -0.5f,   0.f, 0.f,  0.f, 0.f, -1.f,
-            0.5f, -0.5f, -0.5f,   1.f, 0.f,  0.f, 0.f, -1.f,
-            0.5f,  0.5f, -0.5f,   1.f, 1.f,  0.f, 0.f, -1.f,
-            -0.5f,  0.5f, -0.5f,   0.f, 1.f,  0.f, 0.f, -1.f,
-
-            // Front face
-            -0.5f, -0.5f,  0.5f,   0.f, 0.f,  0.f, 0.f,  1.f,
-            0.5f, -0.5f,  0.5f,   1.f, 0.f,  0.f, 0.f,  1.f,
-            0.5f,  0.5f,  0.5f,   1.f, 1.f,  0.f, 0.f,  1.f,
-            -0.5f,  0.5f,  0.5f,   0.f, 1.f,  0.f, 0.f,  1.f,
-
-            // Left face
-            -0.5f,  0.5f,  0.5f,   1.f, 0.f, -1.f, 0.f,  0.f,
-            -0.5f,  0.5f, -0.5f,   1.f, 1.f, -1.f, 0.f,  0.f,
-            -0.5f, -0.5f, -0.5f,   0.f, 1.f, -1.f, 0.f,  0.f,
-            -0.5f, -0.5f,  0.5f,   0.f, 0.f, -1.f, 0.f,  0.f,
-
-            // Right face
-            0.5f,  0.5f,  0.5f,   1.f, 0.f,  1.f, 0.f,  0.f,
-            0.5f,  0.5f, -0.5f,   1.f, 1.f,  1.f, 0.f,  0.f,
-            0.5f, -0.5f, -0.5f,   0.f, 1.f,  1.f, 0.f,  0.f,
-            0.5f, -0.5f,  0.5f,   0.f, 0.f,  1.f, 0.f,  0.f,
-
-            // Bottom face
-            -0.5f, -0.5f, -0.5f,   0.f, 1.f,  0.f, -1.f, 0.f,
-            0.5f, -0.5f, -0.5f,   1.f, 1.f,  0.f, -1.f, 0.f,
-            0.5f, -0.5f,  0.5f,   1.f, 0.f,  0.f, -1.f, 0.f,
-            -0.5f, -0.5f,  0.5f,   0.f, 0.f,  0.f, -1.f, 0.f,
-
-            // Top face
-            -0.5f,  0.5f, -0.5f,   0.f, 1.f,  0.f,  1.f, 0.f,
-            0.5f,  0.5f, -0.5f,   1.f, 1.f,  0.f,  1.f, 0.f,
-            0.5f,  0.5f,  0.5f,   1.f, 0.f,  0.f,  1.f, 0.f,
-            -0.5f,  0.5f,  0.5f,   0.f, 0.f,  0.f,  1.f, 0.f
-    };
-    unsigned int cubeIndices[] = {
-            0,1,2, 2,3,0,
-            4,5,6, 6,7,4,
-            8,9,10,10,11,8,
-            12,13,14,14,15,12,
-            16,17,18,18,19,16,
-            20,21,22,22,23,20
-    };
-
-    unsigned int cubeVAO, cubeVBO, cubeEBO;
-    glGenVertexArrays(1, &cubeVAO);
-    glGenBuffers(1, &cubeVBO);
-    glGenBuffers(1, &cubeEBO);
-
-    glBindVertexArray(cubeVAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cubeEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(cubeIndices), cubeIndices, GL_STATIC_DRAW);
-
-    // Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Texture
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3*sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // Normal
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(5*sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    glBindVertexArray(0);
-
-    // Load texture for cubes
-    unsigned int textureForCubes = loadTexture("resources/textures/texture_08.png");
-
-    // --------------------------------------------------------------------------------
-    // Create the sphere (player)
-    // --------------------------------------------------------------------------------
-    unsigned int sphereVAO, sphereVBO, sphereEBO;
-    float sphereRadius = 0.3f;
-    int sectors = 16;
-    int stacks  = 16;
-    createSphereVAO(sphereRadius, sectors, stacks, sphereVAO, sphereVBO, sphereEBO);
-
-    // Place the player in the middle of a 10x10 grid
-    const int gridSize = 10;
-    playerPos.x = (3 - gridSize / 2.0f);
-    playerPos.y = 0.5f + sphereRadius;
-    playerPos.z = (2 - gridSize / 2.0f);
+    glfwSetWindowRefreshCallback(window, refresh_callback);
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+
+    // Board and starting units come from a compiled map (MapCompiler turns
+    // the JSON sources into .tgmap); the file is mapped, not parsed
+    //   TacticGame [map.tgmap] [--record match.tgrp] [--fps 60] [--vsync 0|1|2] [--no-idle] [--hot-reload]
+    std::string mapPath = "resources/maps/skirmish.tgmap";
+    std::string recordPath;
+    FramePacing pacing;
+    bool hotReload = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--fps" && i + 1 < argc) {
+            pacing.maxFps = std::atof(argv[++i]);
+        } else if (arg == "--vsync" && i + 1 < argc) {
+            pacing.swapInterval = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--no-idle") {
+            pacing.idleWait = false;
+        } else if (arg == "--hot-reload") {
+            hotReload = true;
+        } else {
+            mapPath = arg;
+        }
+    }
+    std::shared_ptr<const MapFile> mapFile = MapFile::open(mapPath);
+    std::vector<MapSpawn> spawns;
+    TileMap tileMap = mapFile ? mapFile->buildTileMap() : defaultBoard(spawns);
+    if (mapFile) {
+        for (int s = 0; s < mapFile->spawnCount(); ++s) {
+            spawns.push_back(mapFile->spawn(s));
+        }
+    } else {
+        spdlog::warn("No map at {}, using the built-in board", mapPath);
+    }
 
-    // Light, sky
-    glm::vec3 lightPos(0.0f, 20.0f, 0.0f);
-    glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
-    glm::vec3 skyColor(0.5f, 0.7f, 1.0f);
-    float skyStrength = 0.2f;
+    // Terrain, units and all their GL resources live on the render thread,
+    // which draws from its own copy of the board
+    RenderThread renderThread(window, tileMap, mapFile);
+    mapFile.reset();
+    if (hotReload) {
+        // Shaders and textures straight from the source tree, so saving
+        // one there shows up in the running game
+        setResourceRoot(TACTICGAME_SOURCE_RESOURCES);
+        renderThread.enableHotReload();
+        spdlog::info("Hot reload: watching {}", resourceRoot());
+    }
+    renderThread.start();
+    RenderFrame renderFrame;
+    const float sphereRadius = SceneRenderer::kUnitRadius;
+
+    Simulation simulation(tileMap);
+    bool havePlayer = false;
+    for (const MapSpawn& spawn : spawns) {
+        if (!tileMap.inBounds(spawn.i, spawn.j)) {
+            continue;
+        }
+        glm::vec3 start = tileMap.tileCenter(spawn.i, spawn.j);
+        start.y = tileMap.topY(spawn.i, spawn.j) + sphereRadius * spawn.scale;
+        // The first unit of team 0 is the one WASD drives
+        if (spawn.team == 0 && !havePlayer) {
+            simulation.setPlayerPosition(start);
+            havePlayer = true;
+            continue;
+        }
+        UnitDesc desc;
+        desc.position  = start;
+        desc.team      = spawn.team;
+        desc.hp        = spawn.hp;
+        desc.moveSpeed = spawn.moveSpeed;
+        desc.scale     = spawn.scale;
+        desc.vision    = spawn.vision;
+        const UnitHandle unit = simulation.units().create(desc);
+        if (spawn.targetI >= 0) {
+            simulation.setTarget(unit, glm::ivec2(spawn.targetI, spawn.targetJ));
+        }
+    }
+
+    // --record: log every tick from here on; TacticReplay re-runs the log
+    // headless and checks it ends in the same state
+    std::unique_ptr<ReplayRecorder> recorder;
+    std::vector<std::uint8_t> snapshot;
+    if (!recordPath.empty()) {
+        saveSnapshot(tileMap, simulation, snapshot);
+        recorder = std::make_unique<ReplayRecorder>(snapshot);
+        simulation.setRecorder(recorder.get());
+    }
+
+    // Worker pool for turn planning; the AI thinks off the frame loop
+    JobSystem jobSystem;
+    AiEvaluator aiEvaluator(jobSystem);
+    std::vector<AiAction> aiOrders;
+
+    // What the player's team (0) can see; enemies outside it aren't drawn
+    FogOfWar fogOfWar(tileMap);
+    std::uint32_t fogRevisionSent = 0;
+    std::vector<glm::vec3> unitPositions;
+
+    // Simulation runs in fixed ticks; rendering interpolates between them
+    FrameClock frameClock;
+    FixedTimestep fixedStep(Simulation::kTickSeconds);
+
+    // Full rate while anything moves; asleep in the event queue otherwise
+    FramePacer pacer(pacing);
+    PresentedFrame presented;
+    // Cursor pixel this frame (-1 = off the framebuffer), and where and
+    // from which camera the last GPU pick was asked for
+    glm::ivec2 cursorPixel(-1, -1);
+    glm::ivec2 pickedPixel(-1, -1);
+    std::uint32_t pickedRevision = 0;
+    // RenderFrame::frameIndex; picks report the frame they were drawn in
+    std::uint64_t framesSubmitted = 0;
 
     while (!glfwWindowShouldClose(window))
     {
-        glfwPollEvents();
+        pacer.waitForFrame();
+        Profiler::instance().beginFrame();
+        const float frameDt = (float)frameClock.tick();
+
+        if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !pPressed) {
+            Profiler::instance().logSummary();
+            pPressed = true;
+        }
+        if (glfwGetKey(window, GLFW_KEY_P) == GLFW_RELEASE) {
+            pPressed = false;
+        }
+        if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS && !tPressed) {
+            Profiler& profiler = Profiler::instance();
+            if (profiler.traceCapture()) {
+                profiler.setTraceCapture(false);
+                if (profiler.writeChromeTrace("profile_trace.json")) {
+                    spdlog::info("Wrote profile_trace.json");
+                }
+            } else {
+                profiler.setTraceCapture(true);
+                spdlog::info("Trace capture started (T to stop)");
+            }
+            tPressed = true;
+        }
+        if (glfwGetKey(window, GLFW_KEY_T) == GLFW_RELEASE) {
+            tPressed = false;
+        }
 
         // 1) Check for toggle C
         if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS && !cPressed) {
-            isFreeCamera = !isFreeCamera;
+            // Also resets the mouse tracking so the view doesn't jump
+            camera.toggleMode();
             cPressed = true;
-            // Optionally reset firstMouse so it doesn't jump
-            firstMouse = true;
+            glfwSetInputMode(window, GLFW_CURSOR, isFreeCamera() ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
         }
         if (glfwGetKey(window, GLFW_KEY_C) == GLFW_RELEASE) {
             cPressed = false;
         }
 
-        // 2) Move either the sphere or the free camera
-        if (!isFreeCamera) {
-            // --- Sphere movement with W/S/A/D (original code) ---
-            if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-                playerPos.z -= playerMoveSpeed;
-            }
-            if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-                playerPos.z += playerMoveSpeed;
-            }
-            if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
-                playerPos.x -= playerMoveSpeed;
+        if (glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS && !gPressed) {
+            chunkedTerrain = !chunkedTerrain;
+            gPressed = true;
+        }
+        if (glfwGetKey(window, GLFW_KEY_G) == GLFW_RELEASE) {
+            gPressed = false;
+        }
+
+        if (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS && !lPressed) {
+            shadowQuality = (ShadowQuality)(((int)shadowQuality + 1) % ((int)ShadowQuality::Pcf5x5 + 1));
+            lPressed = true;
+        }
+        if (glfwGetKey(window, GLFW_KEY_L) == GLFW_RELEASE) {
+            lPressed = false;
+        }
+
+        if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS && !enterPressed) {
+            if (!aiEvaluator.busy()) {
+                aiEvaluator.beginTurn(std::make_shared<const BoardSnapshot>(tileMap, simulation.units()), 1);
             }
-            if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
-                playerPos.x += playerMoveSpeed;
+            enterPressed = true;
+        }
+        if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_RELEASE) {
+            enterPressed = false;
+        }
+        if (aiEvaluator.poll(aiOrders)) {
+            // Orders go through the command queue so they land on a tick
+            // boundary, and in the replay log with it
+            for (const AiAction& order : aiOrders) {
+                simulation.submit(SimCommand{order.unit, order.move});
             }
+            spdlog::info("AI turn: {} orders from {} candidates", aiOrders.size(),
+                         aiEvaluator.candidatesEvaluated());
+        }
+
+        // 2) Move either the sphere or the free camera
+        SimInput simInput;
+        if (!isFreeCamera()) {
+            // --- Sphere movement with W/S/A/D, applied per simulation tick ---
+            simInput.moveForward = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+            simInput.moveBack    = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+            simInput.moveLeft    = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+            simInput.moveRight   = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
         }
         else {
-            // --- FREE CAMERA MOVEMENT with arrow keys ---
-            if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) {
-                freeCamPos += freeCamSpeed * cameraFront;
-            }
-            if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
-                freeCamPos -= freeCamSpeed * cameraFront;
-            }
-            // Strafe left/right
-            glm::vec3 camRight = glm::normalize(glm::cross(cameraFront, cameraUp));
-            if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) {
-                freeCamPos -= freeCamSpeed * camRight;
-            }
-            if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) {
-                freeCamPos += freeCamSpeed * camRight;
+            // --- FREE CAMERA MOVEMENT with arrow keys (view only, per frame) ---
+            camera.updateFree(frameDt,
+                              glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS,
+                              glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS,
+                              glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS,
+                              glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS);
+        }
+
+        {
+            PROFILE_SCOPE("simulation");
+            const int ticks = fixedStep.advance(frameDt);
+            for (int t = 0; t < ticks; ++t) {
+                simulation.tick(simInput);
             }
         }
 
+        if (fogOfWar.update(simulation.units()) && fogOfWar.revision(0) != fogRevisionSent) {
+            fogOfWar.buildMask(0, renderFrame.fog);
+            fogRevisionSent = fogOfWar.revision(0);
+        }
+
         // 3) Close window
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
             glfwSetWindowShouldClose(window, true);
         }
 
         // --- RENDER ---
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        // Build a view matrix
-        glm::mat4 view(1.0f);
-        if (!isFreeCamera) {
-            // Original isometric camera
-            view = glm::lookAt(
-                    cameraPos,
-                    glm::vec3(0.0f, 0.0f, 0.0f),
-                    glm::vec3(0.0f, 1.0f, 0.0f)
-            );
-        } else {
-            // Free camera
-            view = glm::lookAt(
-                    freeCamPos,
-                    freeCamPos + cameraFront,
-                    cameraUp
-            );
-        }
-
-        // Orthographic projection => isometric style
-        glm::mat4 projection = glm::ortho(-zoomLevel, zoomLevel,
-                                          -zoomLevel, zoomLevel,
-                                          -10.f, 10.f);
-
-        // Use our main shader
-        glUseProgram(shaderProgram);
-
-        // Common uniforms
-        glUniform3fv(glGetUniformLocation(shaderProgram, "lightPos"), 1, glm::value_ptr(lightPos));
-        glUniform3fv(glGetUniformLocation(shaderProgram, "lightColor"), 1, glm::value_ptr(lightColor));
-        // For lighting calcs, we always supply the camera position used in the shader
-        glm::vec3 currentCamPos = (isFreeCamera ? freeCamPos : cameraPos);
-        glUniform3fv(glGetUniformLocation(shaderProgram, "viewPos"), 1, glm::value_ptr(currentCamPos));
-
-        glUniform3fv(glGetUniformLocation(shaderProgram, "skyColor"), 1, glm::value_ptr(skyColor));
-        glUniform1f(glGetUniformLocation(shaderProgram, "skyStrength"), skyStrength);
-
-        int useSolidLoc   = glGetUniformLocation(shaderProgram, "useSolidColor");
-        int solidColorLoc = glGetUniformLocation(shaderProgram, "solidColor");
-
-        // Pass view & projection
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"),       1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-
-        // 1) Draw the grid of cubes
-        glBindVertexArray(cubeVAO);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureForCubes);
-        glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
-
-        glUniform1i(useSolidLoc, 0);  // Use texture
-        for (int i = 0; i < gridSize; ++i) {
-            for (int j = 0; j < gridSize; ++j) {
-                glm::mat4 model(1.0f);
-                model = glm::translate(model, glm::vec3(
-                        i - gridSize / 2.0f,
-                        0.0f,
-                        j - gridSize / 2.0f
-                ));
-                glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-
-                glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+        // Cached in the camera; only rebuilt on frames where it moved
+        const SceneView& sceneView = camera.sceneView();
+
+        // Record the frame and hand it over; the render thread draws it
+        // while the next one is simulated
+        simulation.interpolatePositions(fixedStep.alpha(), unitPositions);
+        {
+            const UnitStore& units = simulation.units();
+            renderFrame.units.clear();
+            for (size_t i = 0; i < units.size(); ++i) {
+                if (units.teams()[i] != 0 && !fogOfWar.visible(0, tileMap.tileAt(units.positions()[i]))) {
+                    continue;
+                }
+                renderFrame.units.push(unitPositions[i], units.scales()[i], units.facings()[i], units.teams()[i],
+                                       units.handleAt((std::uint32_t)i).slot);
             }
         }
 
-        // 2) Draw the player sphere
+        // Hover: what's under the cursor (the screen centre in free-camera
+        // mode). The tile comes from a ray walked over the columns; units
+        // come from the GPU pick, a frame or so behind.
         {
-            glm::mat4 model(1.0f);
-            model = glm::translate(model, playerPos);
-
-            glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-
-            // Use a solid color
-            glUniform1i(useSolidLoc, 1);
-            glm::vec3 playerColor(1.0f, 0.2f, 0.2f); // red
-            glUniform3fv(solidColorLoc, 1, glm::value_ptr(playerColor));
-
-            glBindVertexArray(sphereVAO);
+            PROFILE_SCOPE("picking");
+            int windowWidth = 0, windowHeight = 0;
+            glfwGetWindowSize(window, &windowWidth, &windowHeight);
+            glm::vec2 cursor(windowWidth * 0.5f, windowHeight * 0.5f);
+            if (!isFreeCamera()) {
+                double cursorX = 0.0, cursorY = 0.0;
+                glfwGetCursorPos(window, &cursorX, &cursorY);
+                cursor = glm::vec2((float)cursorX, (float)cursorY);
+            }
+            glm::ivec2 hoverTile(-1, -1);
+            cursorPixel = glm::ivec2(-1, -1);
+            if (windowWidth > 0 && windowHeight > 0) {
+                const PickRay ray = screenRay(camera.inverseViewProjection(), cursor,
+                                              glm::vec2((float)windowWidth, (float)windowHeight));
+                pickTile(tileMap, ray, hoverTile);
+
+                // Framebuffer pixels can differ from window coordinates (HiDPI)
+                int framebufferWidth = 0, framebufferHeight = 0;
+                glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+                const int px = (int)(cursor.x * framebufferWidth / windowWidth);
+                const int py = framebufferHeight - 1 - (int)(cursor.y * framebufferHeight / windowHeight);
+                if (px >= 0 && px < framebufferWidth && py >= 0 && py < framebufferHeight) {
+                    cursorPixel = glm::ivec2(px, py);
+                }
+            }
+            const PickResult pick = renderThread.latestPick();
+            if (pick.kind == PickKind::Unit) {
+                // A unit under the cursor highlights the tile it stands on
+                const UnitStore& units = simulation.units();
+                for (size_t i = 0; i < units.size(); ++i) {
+                    if (units.handleAt((std::uint32_t)i).slot == pick.unitId) {
+                        hoverTile = tileMap.tileAt(units.positions()[i]);
+                        break;
+                    }
+                }
+            }
+            renderFrame.highlightTile = hoverTile;
+        }
+        renderFrame.chunkedTerrain = chunkedTerrain;
+        renderFrame.shadowQuality = shadowQuality;
+        renderFrame.swapInterval = pacing.swapInterval;
+        glfwGetFramebufferSize(window, &renderFrame.viewportWidth, &renderFrame.viewportHeight);
+
+        // A new GPU pick only when what's under the cursor could have
+        // changed. The readback finishes between frames, so a pick never
+        // asks for another redraw by itself.
+        const bool unitsMoved = renderFrame.units.positions != presented.unitPositions;
+        const bool pickStale = cursorPixel != pickedPixel || camera.revision() != pickedRevision || unitsMoved;
+        renderFrame.pickPixel = glm::ivec2(-1, -1);
+        if (cursorPixel.x >= 0 && pickStale) {
+            renderFrame.pickPixel = cursorPixel;
+            pacer.markDirty();
+        }
 
-            int sphereIndexCount = 6 * sectors * (stacks - 1);
-            glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+        // Draw only if the picture would differ from the last one, or the
+        // renderer still has frames' worth of work (streaming, rebuilds)
+        if (presented.update(renderFrame, camera.revision()) || windowDamaged || renderThread.hasPendingWork()) {
+            pacer.markDirty();
+        }
+        windowDamaged = false;
+        if (aiEvaluator.busy()) {
+            // Its orders arrive without a window event to wake us
+            pacer.markActive();
+        }
+        if (!pacer.finishUpdate()) {
+            continue;
         }
 
-        glfwSwapBuffers(window);
+        if (renderFrame.pickPixel.x >= 0) {
+            pickedPixel = renderFrame.pickPixel;
+            pickedRevision = camera.revision();
+        }
+        renderFrame.frameIndex = ++framesSubmitted;
+        renderFrame.setView(sceneView);
+        renderFrame.drawTerrain();
+        renderFrame.drawUnits();
+        renderThread.submit(renderFrame);
+
+        // Stay at most a frame ahead of the display, but don't wait out a slow one
+        renderThread.waitForRender(100.0);
     }
 
-    // Cleanup
-    glDeleteVertexArrays(1, &cubeVAO);
-    glDeleteBuffers(1, &cubeVBO);
-    glDeleteBuffers(1, &cubeEBO);
+    spdlog::info("Frames: {} drawn, {} skipped as unchanged", pacer.framesDrawn(), pacer.framesSkipped());
+    Profiler::instance().logSummary();
 
-    glDeleteVertexArrays(1, &sphereVAO);
-    glDeleteBuffers(1, &sphereVBO);
-    glDeleteBuffers(1, &sphereEBO);
+    if (recorder) {
+        simulation.setRecorder(nullptr);
+        saveSnapshot(tileMap, simulation, snapshot);
+        recorder->save(recordPath, snapshotHash(snapshot));
+    }
 
-    glDeleteProgram(shaderProgram);
+    // Cleanup (GL objects must go before the context does)
+    renderThread.stop();
 
     glfwTerminate();
     return 0;
@@ -0,0 +1,6 @@
+#version 330 core
+// Shared by the shadow maps and the depth pre-pass: depth only
+
+void main()
+{
+}
@@ -0,0 +1,28 @@
+#version 330 core
+// Depth pre-pass: the main vertex shader's position math, nothing else
+
+layout(location = 0) in vec3 aPos;
+layout(location = 3) in vec4 aInstance;
+layout(location = 5) in vec4 aModelRow0;
+layout(location = 6) in vec4 aModelRow1;
+layout(location = 7) in vec4 aModelRow2;
+
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 skyColor;
+};
+
+uniform mat4 model;
+
+invariant gl_Position;
+
+void main()
+{
+    mat4 instanceModel = transpose(mat4(aModelRow0, aModelRow1, aModelRow2, vec4(0.0, 0.0, 0.0, 1.0)));
+    vec4 worldPos = model * instanceModel * vec4(aPos + aInstance.xyz, 1.0);
+    gl_Position = projection * view * worldPos;
+}
@@ -0,0 +1,24 @@
+#version 330 core
+// Pick pass output: tile or unit id, tagged by kind
+
+layout(location = 0) out uint PickId;
+
+in vec3 WorldPos;
+in vec3 Normal;
+flat in uint UnitId;
+
+// 0 = terrain, 1 = units
+uniform int pickUnits;
+// world xz + tileOffset = tile coordinates
+uniform vec2 tileOffset;
+uniform int mapWidth;
+
+void main()
+{
+    if (pickUnits != 0) {
+        PickId = 0x40000000u | UnitId;
+    } else {
+        ivec2 tile = ivec2(floor(WorldPos.xz - Normal.xz * 0.01 + tileOffset));
+        PickId = 0x80000000u | uint(tile.y * mapWidth + tile.x);
+    }
+}
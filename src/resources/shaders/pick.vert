@@ -0,0 +1,29 @@
+#version 330 core
+// Pick pass: object IDs into PickBuffer's R32UI pixel. Tiles are found from
+// the fragment's world position (nudged into the column, so side faces
+// don't land on the neighbour); units carry their RenderUnits id.
+
+layout(location = 0) in vec3 aPos;
+layout(location = 2) in vec3 aNormal;
+layout(location = 3) in vec4 aInstance;
+layout(location = 5) in vec4 aModelRow0;
+layout(location = 6) in vec4 aModelRow1;
+layout(location = 7) in vec4 aModelRow2;
+layout(location = 8) in float aPickId;
+
+uniform mat4 viewProjection;
+uniform mat4 model;
+
+out vec3 WorldPos;
+out vec3 Normal;
+flat out uint UnitId;
+
+void main()
+{
+    mat4 instanceModel = transpose(mat4(aModelRow0, aModelRow1, aModelRow2, vec4(0.0, 0.0, 0.0, 1.0)));
+    vec4 worldPos = model * instanceModel * vec4(aPos + aInstance.xyz, 1.0);
+    WorldPos = vec3(worldPos);
+    Normal = aNormal;
+    UnitId = uint(aPickId);
+    gl_Position = viewProjection * worldPos;
+}
@@ -0,0 +1,114 @@
+#version 330 core
+// Main fragment shader (with "sky" lighting), built in variants:
+//   SOLID_COLOR  colour by team instead of the tile texture (units)
+//   FOG_OF_WAR   darken what the player's team can't see
+//   SHADOWS      directional shadows from the static + unit shadow maps
+
+out vec4 FragColor;
+
+in vec2 TexCoord;
+in vec3 Normal;
+in vec3 FragPos;
+flat in float TexLayer;
+
+// Per-frame camera/light state shared by all programs ("sky" colour + strength in skyColor)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 skyColor;
+};
+
+// Tile materials, one layer per tile type (out-of-range layers clamp)
+uniform sampler2DArray tileTextures;
+
+#ifdef FOG_OF_WAR
+// One R8 texel per tile (1 = visible, ~0.4 = explored, 0 = unseen).
+// fogTransform maps world xz to texture coordinates: xz * xy + zw.
+uniform sampler2D fogTexture;
+uniform vec4 fogTransform;
+#endif
+
+#ifdef SOLID_COLOR
+// TexLayer holds the team
+uniform vec3 teamColors[4];
+#else
+// Hovered tile column, world xz min (xy) and max (zw); empty when min > max
+uniform vec4 highlightRect;
+#endif
+
+#ifdef SHADOWS
+// Terrain (cached) and units (per frame); the matrices map world space to
+// texture coordinates + depth
+uniform sampler2DShadow staticShadowMap;
+uniform sampler2DShadow unitShadowMap;
+uniform mat4 staticShadowMatrix;
+uniform mat4 unitShadowMatrix;
+// PCF kernel radius in texels: 0 = one hardware-filtered tap
+uniform int shadowPcfRadius;
+
+float sampleShadow(sampler2DShadow shadowMap, mat4 shadowMatrix, vec3 worldPos)
+{
+    vec3 coord = (shadowMatrix * vec4(worldPos, 1.0)).xyz;
+    vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0));
+    float lit = 0.0;
+    for (int y = -shadowPcfRadius; y <= shadowPcfRadius; ++y) {
+        for (int x = -shadowPcfRadius; x <= shadowPcfRadius; ++x) {
+            lit += texture(shadowMap, vec3(coord.xy + vec2(x, y) * texel, coord.z));
+        }
+    }
+    float taps = float(2 * shadowPcfRadius + 1);
+    return lit / (taps * taps);
+}
+#endif
+
+void main()
+{
+    // Ambient lighting
+    float ambientStrength = 0.2;
+    vec3 ambient = ambientStrength * lightColor.rgb;
+    ambient += skyColor.a * skyColor.rgb;
+
+    // Diffuse lighting
+    vec3 norm = normalize(Normal);
+    // w = 0: directional, xyz points toward the light
+    vec3 lightDir = lightPos.w == 0.0 ? normalize(lightPos.xyz) : normalize(lightPos.xyz - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor.rgb;
+
+    // Specular lighting
+    float specularStrength = 0.5;
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+    vec3 specular = specularStrength * spec * lightColor.rgb;
+
+    // Combine them
+#ifdef SHADOWS
+    // Nudge the lookup along the normal to keep lit faces off their own depth
+    vec3 shadowPos = FragPos + norm * 0.02;
+    float shadow = min(sampleShadow(staticShadowMap, staticShadowMatrix, shadowPos),
+                       sampleShadow(unitShadowMap, unitShadowMatrix, shadowPos));
+    vec3 lighting = ambient + shadow * (diffuse + specular);
+#else
+    vec3 lighting = ambient + diffuse + specular;
+#endif
+
+#ifdef FOG_OF_WAR
+    float visibility = texture(fogTexture, FragPos.xz * fogTransform.xy + fogTransform.zw).r;
+    lighting *= mix(0.15, 1.0, visibility);
+#endif
+
+#ifdef SOLID_COLOR
+    FragColor = vec4(lighting * teamColors[int(TexLayer) & 3], 1.0);
+#else
+    if (all(greaterThanEqual(FragPos.xz, highlightRect.xy)) && all(lessThanEqual(FragPos.xz, highlightRect.zw))) {
+        lighting = mix(lighting, vec3(1.0, 1.0, 0.6), 0.35);
+    }
+    // Use a texture
+    vec3 texColor = texture(tileTextures, vec3(TexCoord, TexLayer)).rgb;
+    FragColor = vec4(lighting * texColor, 1.0);
+#endif
+}
@@ -0,0 +1,53 @@
+#version 330 core
+// Main vertex shader: tiles (instanced or baked chunks) and unit spheres
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec3 aNormal;
+// Per-instance data (xyz = offset, w = tile type or unit team). VAOs that
+// don't enable it read the current value, which SceneRenderer zeroes at startup.
+layout(location = 3) in vec4 aInstance;
+// Per-vertex material layer (baked chunks) or per-instance team (units).
+// Reads 0 when not enabled.
+layout(location = 4) in float aLayer;
+// Per-instance unit transform as the rows of a mat3x4 (rotation * scale |
+// translation). Reads as identity rows when not enabled.
+layout(location = 5) in vec4 aModelRow0;
+layout(location = 6) in vec4 aModelRow1;
+layout(location = 7) in vec4 aModelRow2;
+
+out vec2 TexCoord;
+out vec3 Normal;
+out vec3 FragPos;
+flat out float TexLayer;
+
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 skyColor; // a = sky strength
+};
+
+uniform mat4 model;
+// inverse-transpose of mat3(model), computed on the CPU once per draw.
+// Instance offsets are pure translations, and instance transforms only
+// rotate and scale uniformly, so neither needs its own.
+uniform mat3 normalMatrix;
+
+// The depth pre-pass computes gl_Position with the same expressions, so
+// its depths match these exactly
+invariant gl_Position;
+
+void main()
+{
+    mat4 instanceModel = transpose(mat4(aModelRow0, aModelRow1, aModelRow2, vec4(0.0, 0.0, 0.0, 1.0)));
+    vec4 worldPos = model * instanceModel * vec4(aPos + aInstance.xyz, 1.0);
+    FragPos = vec3(worldPos);
+    Normal = normalMatrix * (mat3(instanceModel) * aNormal);
+    TexCoord = aTexCoord;
+    // Only one of the two is enabled for any tile VAO
+    TexLayer = aInstance.w + aLayer;
+    gl_Position = projection * view * worldPos;
+}
@@ -0,0 +1,18 @@
+#version 330 core
+// Depth-only shader for the shadow maps: same transform inputs as the main
+// vertex shader, no outputs
+
+layout(location = 0) in vec3 aPos;
+layout(location = 3) in vec4 aInstance;
+layout(location = 5) in vec4 aModelRow0;
+layout(location = 6) in vec4 aModelRow1;
+layout(location = 7) in vec4 aModelRow2;
+
+uniform mat4 lightSpace;
+uniform mat4 model;
+
+void main()
+{
+    mat4 instanceModel = transpose(mat4(aModelRow0, aModelRow1, aModelRow2, vec4(0.0, 0.0, 0.0, 1.0)));
+    gl_Position = lightSpace * model * instanceModel * vec4(aPos + aInstance.xyz, 1.0);
+}